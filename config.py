@@ -10,6 +10,10 @@ def get_doc_classes():
     return [
         "Wasm",
         "WasmMemory",
+        "WasmFunction",
+        "WasmCall",
+        "WasmModule",
+        "WasmPool",
     ]
 
 
@@ -8,6 +8,7 @@ func _ready():
 	$"%PrimeLimit".connect("value_changed", Callable(self, "_benchmark"))
 	$"%MemoryType".connect("item_selected", Callable(self, "_update_memory_type"))
 	$"%CallbackButton".connect("pressed", Callable(wasm, "function").bind("invoke_callback", []))
+	$"%BenchmarkButton".connect("pressed", Callable(self, "_benchmark_calls")) # Slow so run on demand only
 	for node in $"%MemoryInput".get_children() + [$"%MemoryOffset"]:
 		node.connect("value_changed" if node is Range else "text_changed", Callable(self, "_update_memory"))
 	for item in ["Int", "Float", "String"]: $"%MemoryType".add_item(item)
@@ -112,3 +113,11 @@ func _benchmark(_value = 0):
 	$"%PrimeAnswer".text = ("%d" % v_gdscript) if v_gdscript == v_wasm else "?"
 	$"%TimeGDScript".text = "%.3f ms" % (t_gdscript / 1000.0)
 	$"%TimeWasm".text = "%.3f ms" % (t_wasm / 1000.0)
+
+func _benchmark_calls():
+	# Modules are those of the test project, linked into this project as res://modules
+	var bytecode = FileAccess.get_file_as_bytes("res://example.wasm")
+	CallBenchmark.run(wasm, bytecode)
+	CompileBenchmark.run(bytecode, "res://modules")
+	ThreadBenchmark.run(bytecode)
+	MemoryBenchmark.run("res://modules")
@@ -0,0 +1,44 @@
+extends RefCounted
+class_name CallBenchmark
+
+# Overhead of calls between GDScript and Wasm
+
+static func call_overhead(wasm: Wasm, name: String, args: Array, iterations: int = 10000) -> float:
+	# Average microseconds per exported function call
+	var t = Time.get_ticks_usec()
+	for _i in iterations: wasm.function(name, args)
+	return float(Time.get_ticks_usec() - t) / iterations
+
+static func handle_overhead(function: WasmFunction, args: Array, iterations: int = 10000) -> float:
+	# Average microseconds per call via a resolved function handle
+	var t = Time.get_ticks_usec()
+	for _i in iterations: function.invokev(args)
+	return float(Time.get_ticks_usec() - t) / iterations
+
+static func batch_overhead(wasm: Wasm, name: String, args: PackedInt64Array, stride: int) -> float:
+	# Average microseconds per row of a batched exported function call
+	var t = Time.get_ticks_usec()
+	wasm.function_batch(name, args, stride)
+	return float(Time.get_ticks_usec() - t) / (args.size() / stride)
+
+static func import_overhead(bytecode: PackedByteArray, iterations: int = 10000) -> float:
+	# Average microseconds per export call that invokes a single import
+	var target = CallBenchmark.new()
+	var wasm = Wasm.new()
+	wasm.load(bytecode, { "functions": { "index.callback": [target, "_echo"] } })
+	var t = Time.get_ticks_usec()
+	for _i in iterations: wasm.function("invoke_callback", [])
+	return float(Time.get_ticks_usec() - t) / iterations
+
+static func run(wasm: Wasm, bytecode: PackedByteArray):
+	print("Function call overhead: %.3f µs" % call_overhead(wasm, "update_memory", []))
+	print("Function handle call overhead: %.3f µs" % handle_overhead(wasm.get_function("update_memory"), []))
+	var rows = PackedInt64Array()
+	rows.resize(10000)
+	rows.fill(8)
+	print("Function call overhead: %.3f µs (unbatched)" % call_overhead(wasm, "fibonacci", [8]))
+	print("Function call overhead: %.3f µs (batched)" % batch_overhead(wasm, "fibonacci", rows, 1))
+	print("Import call overhead: %.3f µs" % import_overhead(bytecode))
+
+func _echo(value):
+	return value
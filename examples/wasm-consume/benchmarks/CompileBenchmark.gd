@@ -0,0 +1,27 @@
+extends RefCounted
+class_name CompileBenchmark
+
+# Time to compile modules with the configured engine
+
+static func compile_time(bytecode: PackedByteArray, iterations: int = 10) -> float:
+	# Average microseconds to compile a module
+	var wasm = Wasm.new()
+	var t = Time.get_ticks_usec()
+	for _i in iterations: wasm.compile(bytecode)
+	return float(Time.get_ticks_usec() - t) / iterations
+
+static func compile_times(directory: String, iterations: int = 10) -> Dictionary:
+	# Average microseconds to compile each module in a directory
+	var times = {}
+	for file in DirAccess.get_files_at(directory):
+		if file.get_extension() != "wasm": continue
+		times[file] = compile_time(FileAccess.get_file_as_bytes(directory.path_join(file)), iterations)
+	return times
+
+static func run(bytecode: PackedByteArray, modules: String):
+	# Module cache serves repeat compilations from disk so times then measure cache hits rather than compilation
+	var cached = ProjectSettings.get_setting("godot_wasm/module_cache/enabled", false)
+	var suffix = ", module cache hit" if cached else ""
+	print("Compile time: %.3f µs%s" % [compile_time(bytecode), " (module cache hit)" if cached else ""])
+	var times = compile_times(modules)
+	for file in times: print("Compile time: %.3f µs (%s%s)" % [times[file], file, suffix])
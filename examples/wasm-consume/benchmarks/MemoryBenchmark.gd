@@ -0,0 +1,37 @@
+extends RefCounted
+class_name MemoryBenchmark
+
+# Cost of passing buffers between instances
+
+static func pipeline(modules: String, stages: int = 3, size: int = 16384, iterations: int = 100) -> Dictionary:
+	# Average microseconds per pass of a buffer through stages sharing one memory versus copying into each
+	var bytecode = FileAccess.get_file_as_bytes(modules.path_join("memory.wasm"))
+	var source = Wasm.new()
+	source.load(bytecode, {})
+	source.memory.reserve(100) # Satisfy minimum of importing modules
+	var module = WasmModule.new()
+	module.compile(FileAccess.get_file_as_bytes(modules.path_join("memory-import.wasm")))
+	var shared = [source]
+	for _i in stages - 1: shared.append(module.instantiate({ "memory": source.memory }))
+	var copied = []
+	for _i in stages:
+		var wasm = Wasm.new()
+		wasm.load(bytecode, {})
+		copied.append(wasm)
+	var data = "x".repeat(size)
+	var t = Time.get_ticks_usec()
+	for _i in iterations:
+		source.memory.seek(source.global("offset")).put_string(data)
+		for wasm in shared: wasm.function("ascii_sum", [])
+	var times = { "shared": float(Time.get_ticks_usec() - t) / iterations }
+	t = Time.get_ticks_usec()
+	for _i in iterations:
+		for wasm in copied:
+			wasm.memory.seek(wasm.global("offset")).put_string(data)
+			wasm.function("ascii_sum", [])
+	times["copied"] = float(Time.get_ticks_usec() - t) / iterations
+	return times
+
+static func run(modules: String):
+	var times = pipeline(modules)
+	print("Pipeline pass: %.3f µs (shared memory), %.3f µs (copied memory)" % [times.shared, times.copied])
@@ -0,0 +1,45 @@
+extends RefCounted
+class_name ThreadBenchmark
+
+# Scaling of independent instances across threads
+
+static func parallel_speedup(bytecode: PackedByteArray, threads: int, limit: int = 1000000) -> float:
+	# Ratio of serial to parallel runtime of independent instances, one per thread
+	var target = ThreadBenchmark.new()
+	var module = WasmModule.new()
+	module.compile(bytecode)
+	var instances = []
+	for _i in threads: instances.append(module.instantiate({ "functions": { "index.callback": [target, "_echo"] } }))
+	var t = Time.get_ticks_usec()
+	for wasm in instances: wasm.function("sieve", [limit])
+	var serial = Time.get_ticks_usec() - t
+	t = Time.get_ticks_usec()
+	var task = WorkerThreadPool.add_group_task(func(i): instances[i].function("sieve", [limit]), threads)
+	WorkerThreadPool.wait_for_group_task_completion(task)
+	return float(serial) / (Time.get_ticks_usec() - t)
+
+static func pool_scaling(bytecode: PackedByteArray, sizes: Array = [1, 2, 4, 8, 16], rows: int = 256, limit: int = 100000) -> Dictionary:
+	# Average microseconds per row dispatched over pools of increasing size
+	var target = ThreadBenchmark.new()
+	var module = WasmModule.new()
+	module.compile(bytecode)
+	var args = PackedInt64Array()
+	args.resize(rows)
+	args.fill(limit)
+	var times = {}
+	for size in sizes:
+		var pool = WasmPool.new()
+		pool.instantiate(module, size, { "functions": { "index.callback": [target, "_echo"] } })
+		var t = Time.get_ticks_usec()
+		pool.dispatch("sieve", args, 1)
+		times[size] = float(Time.get_ticks_usec() - t) / rows
+	return times
+
+static func run(bytecode: PackedByteArray):
+	var threads = OS.get_processor_count()
+	print("Parallel speedup: %.2fx (%d threads)" % [parallel_speedup(bytecode, threads), threads])
+	var scaling = pool_scaling(bytecode)
+	for size in scaling: print("Pool dispatch: %.3f µs per row (%d instances, %.2fx)" % [scaling[size], size, scaling[1] / scaling[size]])
+
+func _echo(value):
+	return value
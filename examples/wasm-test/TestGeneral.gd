@@ -48,6 +48,69 @@ func test_invalid_binary():
 	expect_eq(error, ERR_INVALID_DATA)
 	expect_error("Invalid binary")
 
+func test_compile_async():
+	var wasm = Wasm.new()
+	var error = wasm.compile_async(read_file("simple"))
+	expect_eq(error, OK)
+	expect_eq(wasm.is_compiling(), true)
+	# Completion is signalled on the main thread; instance is unusable until then
+	error = wasm.instantiate({})
+	expect_eq(error, ERR_BUSY)
+	expect_error("Compilation in progress")
+	error = wasm.compile_async(read_file("simple"))
+	expect_eq(error, ERR_BUSY)
+	expect_error("Compilation in progress")
+
+func test_serialize():
+	var wasm = Wasm.new()
+	var error = wasm.compile(read_file("simple"))
+	expect_eq(error, OK)
+	var bytes = wasm.serialize()
+	expect_eq(bytes.is_empty(), false)
+	wasm = Wasm.new()
+	error = wasm.compile_serialized(bytes)
+	expect_eq(error, OK)
+	error = wasm.instantiate({})
+	expect_eq(error, OK)
+	expect_eq(wasm.function("add", [1, 2]), 3)
+	expect_empty()
+
+func test_invalid_serialize():
+	var wasm = Wasm.new()
+	var bytes = wasm.serialize()
+	expect_eq(bytes.is_empty(), true)
+	expect_error("Serialization failed")
+	var error = wasm.compile_serialized(Utils.to_utf8("asdf"))
+	expect_eq(error, ERR_INVALID_DATA)
+	expect_error("Deserialization failed")
+
+func test_shared_module():
+	var module = WasmModule.new()
+	var error = module.compile(read_file("simple"))
+	expect_eq(error, OK)
+	var a = module.instantiate({})
+	var b = Wasm.new()
+	b.module = module
+	error = b.instantiate({})
+	expect_eq(error, OK)
+	expect_eq(a.module, b.module)
+	# Instances share code but not state
+	expect_eq(a.function("count"), 1)
+	expect_eq(a.function("count"), 2)
+	expect_eq(b.function("count"), 1)
+	expect_empty()
+
+func test_invalid_shared_module():
+	var module = WasmModule.new()
+	var wasm = module.instantiate({})
+	expect_eq(wasm, null)
+	expect_error("Not compiled")
+	var error = module.compile(read_file("simple"))
+	expect_eq(error, OK)
+	error = module.compile(read_file("simple"))
+	expect_eq(error, ERR_ALREADY_IN_USE)
+	expect_error("Module already compiled")
+
 func test_function():
 	var wasm = load_wasm("simple")
 	var result = wasm.function("add", [1, 2])
@@ -93,6 +156,188 @@ func test_function_default_args():
 	expect_eq(result, null)
 	expect_error("Incorrect number of arguments supplied")
 
+func test_function_batch():
+	var wasm = load_wasm("simple")
+	var result = wasm.function_batch("add", PackedInt64Array([1, 2, 3, 4, 5, 6]), 2)
+	expect_type(result, TYPE_PACKED_INT64_ARRAY)
+	expect_eq(result, PackedInt64Array([3, 7, 11]))
+	result = wasm.function_batch("add", PackedFloat64Array([1.0, 2.0, 0.0]), 3) # Padded rows
+	expect_eq(result, PackedInt64Array([3]))
+	expect_empty()
+
+func test_invalid_function_batch():
+	var wasm = load_wasm("simple")
+	var result = wasm.function_batch("add", PackedInt64Array([1, 2, 3]), 1)
+	expect_eq(result, null)
+	expect_error("Invalid stride")
+	result = wasm.function_batch("add", PackedInt64Array([1, 2, 3]), 2)
+	expect_eq(result, null)
+	expect_error("Argument count not a multiple of stride")
+	result = wasm.function_batch("add", [1, 2], 2)
+	expect_eq(result, null)
+	expect_error("Unsupported argument array type")
+
+func test_function_handle():
+	var wasm = load_wasm("simple")
+	var add = wasm.get_function("add")
+	expect_eq(add.get_name(), "add")
+	expect_eq(add.invoke(1, 2), 3)
+	expect_eq(add.invokev([3, 4]), 7)
+	expect_empty()
+
+func test_invalid_function_handle():
+	var wasm = load_wasm("simple")
+	var result = wasm.get_function("asdf")
+	expect_eq(result, null)
+	expect_error("Unknown function name asdf")
+	var add = wasm.get_function("add")
+	result = add.invoke(1)
+	expect_eq(result, null)
+	expect_error("Incorrect number of arguments supplied")
+
+func test_stale_function_handle():
+	var wasm = load_wasm("simple")
+	var add = wasm.get_function("add")
+	var error = wasm.instantiate({})
+	expect_eq(error, OK)
+	var result = add.invoke(1, 2)
+	expect_eq(result, null)
+	expect_error("Stale function add")
+
+func test_function_resumable():
+	var wasm = load_wasm("simple")
+	var call = wasm.function_resumable("add", [1, 2])
+	expect_eq(call.get_name(), "add")
+	while !call.resume(10): pass
+	expect_eq(call.is_done(), true)
+	expect_eq(call.get_result(), 3)
+	expect_eq(wasm.is_calling(), false)
+	expect_eq(wasm.function("add", [3, 4]), 7)
+	expect_empty()
+
+func test_invalid_function_resumable():
+	var wasm = Wasm.new()
+	expect_eq(wasm.function_resumable("add", [1, 2]), null)
+	expect_error("Not instantiated")
+	wasm = load_wasm("simple")
+	expect_eq(wasm.function_resumable("asdf"), null)
+	expect_error("Unknown function name asdf")
+
+func test_execution_budget():
+	var wasm = load_wasm("simple")
+	expect_eq(wasm.execution_budget, 0)
+	expect_eq(wasm.set_execution_budget(-1), ERR_INVALID_PARAMETER)
+	expect_error("Invalid execution budget")
+	var error = wasm.set_execution_budget(1)
+	if error != OK: # Metering disabled or unsupported by runtime
+		expect_eq(error, ERR_UNAVAILABLE)
+		expect_error("Execution budget unavailable without metering")
+		expect_eq(wasm.execution_budget, 0)
+		return
+	expect_eq(wasm.function("add", [1, 2]), null)
+	expect_error("Execution budget exceeded calling function add")
+	expect_eq(wasm.get_last_error(), ERR_TIMEOUT)
+	wasm.execution_budget = 1000
+	expect_eq(wasm.function("add", [1, 2]), 3)
+	expect_eq(wasm.get_last_error(), OK)
+	expect_empty()
+
+func test_last_error():
+	var wasm = load_wasm("simple")
+	expect_eq(wasm.get_last_error(), OK)
+	expect_eq(wasm.function("asdf"), null)
+	expect_error("Unknown function name asdf")
+	expect_eq(wasm.get_last_error(), FAILED)
+	expect_eq(wasm.function("add", [1, 2]), 3)
+	expect_eq(wasm.get_last_error(), OK)
+
+func test_pool_dispatch():
+	var module = WasmModule.new()
+	module.compile(read_file("simple"))
+	var pool = WasmPool.new()
+	var error = pool.instantiate(module, 4, {})
+	expect_eq(error, OK)
+	expect_eq(pool.get_size(), 4)
+	var args = PackedInt64Array()
+	var expected = PackedInt64Array()
+	for i in 1000:
+		args.append_array([i, i * 2])
+		expected.append(i * 3)
+	expect_eq(pool.dispatch("add", args, 2), expected)
+	expect_eq(pool.dispatch("add", PackedInt64Array([1, 2]), 2), PackedInt64Array([3]))
+	expect_empty()
+
+func test_invalid_pool_dispatch():
+	var pool = WasmPool.new()
+	expect_eq(pool.dispatch("add", PackedInt64Array([1, 2]), 2), null)
+	expect_error("Not instantiated")
+	var module = WasmModule.new()
+	module.compile(read_file("simple"))
+	pool.instantiate(module, 2, {})
+	expect_eq(pool.dispatch("add", PackedInt64Array([1, 2, 3]), 2), null)
+	expect_error("Argument count not a multiple of stride")
+	expect_eq(pool.dispatch("add", [1, 2], 2), null)
+	expect_error("Unsupported argument array type")
+	expect_eq(pool.dispatch("asdf", PackedInt64Array([1, 2, 3, 4]), 2), null)
+	expect_error("Unknown function name asdf")
+
+func test_snapshot_globals():
+	var wasm = load_wasm("simple")
+	var snapshot = wasm.snapshot()
+	expect_eq(snapshot.get("globals"), { "global_mut": 42 })
+	expect(!snapshot.has("memory"))
+	expect_eq(wasm.restore(snapshot), OK)
+	expect_eq(wasm.restore({ "globals": { "asdf": 0 } }), ERR_INVALID_DATA)
+	expect_error("Unknown global name asdf")
+	expect_eq(wasm.restore({ "globals": { "global_const": 1.0 } }), ERR_INVALID_DATA)
+	expect_error("Invalid snapshot global global_const")
+	expect_eq(wasm.restore({ "globals": { "global_mut": {} } }), ERR_INVALID_DATA)
+	expect_error("Unsupported Godot variant type")
+	expect_error("Invalid snapshot global global_mut")
+	expect_eq(wasm.global("global_mut"), 42)
+
+func test_preinitialize():
+	var bytecode = Wasm.new().preinitialize(read_file("simple"), {})
+	expect(!bytecode.is_empty())
+	var wasm = Wasm.new()
+	expect_eq(wasm.load(bytecode, {}), OK)
+	expect(!wasm.inspect().get("export_functions").has("_initialize"))
+	expect_eq(wasm.global("global_mut"), 42)
+	expect_eq(wasm.function("count"), 1)
+	# Initialized memory and globals are baked into module
+	var expected = load_wasm("memory")
+	wasm = Wasm.new()
+	expect_eq(wasm.load(Wasm.new().preinitialize(read_file("memory"), {}), {}), OK)
+	expect_eq(wasm.global("offset"), expected.global("offset"))
+	expect_eq(wasm.snapshot().get("memory"), expected.snapshot().get("memory"))
+	# Passive segments are baked as dropped; _initialize and init both copy passive segment 0 to address 0
+	bytecode = Wasm.new().preinitialize(make_bytes([0, 97, 115, 109, 1, 0, 0, 0, 1, 4, 1, 96, 0, 0, 3, 3, 2, 0, 0, 5, 3, 1, 0, 1, 7, 31, 3, 11, 95, 105, 110, 105, 116, 105, 97, 108, 105, 122, 101, 0, 0, 4, 105, 110, 105, 116, 0, 1, 6, 109, 101, 109, 111, 114, 121, 2, 0, 12, 1, 1, 10, 27, 2, 12, 0, 65, 0, 65, 0, 65, 1, 252, 8, 0, 0, 11, 12, 0, 65, 0, 65, 0, 65, 1, 252, 8, 0, 0, 11, 11, 4, 1, 1, 1, 42]), {})
+	wasm = Wasm.new()
+	expect_eq(wasm.load(bytecode, {}), OK)
+	expect_eq(wasm.memory.seek(0).get_u8(), 42)
+	wasm.function("init", [])
+	expect_error("Failed calling function init")
+	expect_empty()
+
+func test_preinitialize_preserves_instance():
+	var wasm = load_wasm("simple")
+	var module = wasm.get_module()
+	expect(!wasm.preinitialize(read_file("memory"), {}).is_empty())
+	expect_eq(wasm.get_module(), module)
+	expect_eq(wasm.function("add", [1, 2]), 3)
+	expect(wasm.preinitialize(make_bytes([0, 1, 2, 3]), {}).is_empty())
+	expect_error("Invalid module header")
+	expect_eq(wasm.global("global_mut"), 42)
+
+func test_invalid_preinitialize():
+	var bytecode = Wasm.new().preinitialize(make_bytes([0, 1, 2, 3]), {})
+	expect(bytecode.is_empty())
+	expect_error("Invalid module header")
+	# Mutable externref global
+	bytecode = Wasm.new().preinitialize(make_bytes([0, 97, 115, 109, 1, 0, 0, 0, 6, 6, 1, 111, 1, 208, 111, 11]), {})
+	expect(bytecode.is_empty())
+	expect_error("Mutable reference or vector globals unsupported")
+
 func test_global():
 	var wasm = load_wasm("simple")
 	var global_const = wasm.global("global_const")
@@ -90,6 +90,40 @@ func test_callback_function():
 	expect_log("Dummy import -123")
 	expect_log("Dummy import -12.34")
 
+func test_callable_imports():
+	var imports = { "functions": {
+		"import.import_int": func(a): print("Lambda import %s" % a),
+		"import.import_float": _dummy_import.bind("bound"),
+	} }
+	var wasm = load_wasm("import", imports)
+	wasm.function("callback", [])
+	expect_log("Lambda import -123")
+	expect_log("Dummy import -12.34 bound")
+
+func test_callback_resumable():
+	var threads = []
+	var imports = { "functions": {
+		"import.import_int": func(_a): threads.append(OS.get_thread_caller_id()),
+		"import.import_float": func(_a): threads.append(OS.get_thread_caller_id()),
+	} }
+	var wasm = load_wasm("import", imports)
+	var call = wasm.function_resumable("callback", [])
+	while !call.resume(10): pass
+	expect_eq(threads, [OS.get_main_thread_id(), OS.get_main_thread_id()])
+	expect_empty()
+
+func test_invocation_freed_callable_target():
+	var target = ImportTarget.new()
+	var imports = { "functions": {
+		"import.import_int": Callable(target, "_dummy_import"),
+		"import.import_float": Callable(target, "_dummy_import"),
+	} }
+	var wasm = load_wasm("import", imports)
+	target.free() # Free target before invocation
+	wasm.function("callback", [])
+	expect_error("Failed to retrieve import function target")
+	expect_error("Failed calling function callback")
+
 func test_inspect():
 	# Import module post-instantiation
 	var imports = { "functions": {
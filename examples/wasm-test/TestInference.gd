@@ -11,3 +11,17 @@ func test_param_types():
 	expect_eq(wasm.function("add_i64", [3, -1]), 2)
 	expect_approx(wasm.function("add_f32", [3.5, -1.2]), 2.3)
 	expect_approx(wasm.function("add_f64", [3.5, -1.2]), 2.3)
+
+func test_batch_types():
+	var wasm = load_wasm("inference", { "functions": {
+		"inference.echo_i32": dummy_import(),
+		"inference.echo_i64": dummy_import(),
+		"inference.echo_f32": dummy_import(),
+		"inference.echo_f64": dummy_import(),
+	} })
+	var result = wasm.function_batch("add_f64", PackedFloat64Array([3.5, -1.2, 1.0, 1.5]), 2)
+	expect_type(result, TYPE_PACKED_FLOAT64_ARRAY)
+	expect_approx(result[0], 2.3)
+	expect_approx(result[1], 2.5)
+	result = wasm.function_batch("add_i32", PackedInt64Array([3, -1]), 2)
+	expect_eq(result, PackedInt64Array([2]))
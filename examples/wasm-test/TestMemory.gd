@@ -75,6 +75,103 @@ func test_memory_ops():
 	expect_eq(result.front(), OK)
 	expect_eq(result.back(), data)
 
+func test_memory_bulk():
+	var wasm = load_wasm("memory")
+	var offset = wasm.global("offset")
+	# Written values match stream reads
+	var floats = PackedFloat32Array([0.5, -1.25, 3.0])
+	expect_eq(wasm.memory.write_floats(offset, floats), OK)
+	expect_eq(wasm.memory.read_floats(offset, 3), floats)
+	expect_eq(wasm.memory.seek(offset).get_float(), 0.5)
+	var vectors = PackedVector3Array([Vector3(1, 2, 3), Vector3(4, 5, 6)])
+	expect_eq(wasm.memory.write_vector3s(offset, vectors), OK)
+	expect_eq(wasm.memory.read_vector3s(offset, 2), vectors)
+	var data = make_bytes([0xF0, 0xF1, 0xF2, 0xF3])
+	expect_eq(wasm.memory.write_bytes(offset, data), OK)
+	expect_eq(wasm.memory.read_bytes(offset, 4), data)
+	expect_eq(wasm.memory.read_int32s(offset, 1), PackedInt32Array([0xF3F2F1F0 - (1 << 32)]))
+	expect_eq(wasm.function("load_byte", [0]), 0xF0)
+	expect_eq(wasm.memory.read_bytes(offset, 0), PackedByteArray())
+	expect_empty()
+
+func test_invalid_memory_bulk():
+	var wasm = load_wasm("memory")
+	var size = wasm.inspect().get("memory").get("current")
+	expect_eq(wasm.memory.read_bytes(size - 2, 4), PackedByteArray())
+	expect_error("Memory access out of bounds")
+	expect_eq(wasm.memory.read_doubles(-8, 1), PackedFloat64Array())
+	expect_error("Memory access out of bounds")
+	expect_eq(wasm.memory.write_int64s(size - 4, PackedInt64Array([1])), ERR_PARAMETER_RANGE_ERROR)
+	expect_error("Memory access out of bounds")
+	var memory = WasmMemory.new()
+	expect_eq(memory.write_bytes(0, make_bytes([1])), ERR_INVALID_DATA)
+	expect_error("Invalid memory")
+
+func test_memory_bulk_ops():
+	var wasm = load_wasm("memory")
+	var offset = wasm.global("offset")
+	expect_eq(wasm.memory.fill(offset, 0xAB, 8), OK)
+	expect_eq(wasm.memory.read_bytes(offset, 8), make_bytes([0xAB, 0xAB, 0xAB, 0xAB, 0xAB, 0xAB, 0xAB, 0xAB]))
+	wasm.memory.write_bytes(offset, make_bytes([1, 2, 3, 4]))
+	expect_eq(wasm.memory.copy(offset + 2, offset, 4), OK) # Overlapping
+	expect_eq(wasm.memory.read_bytes(offset, 6), make_bytes([1, 2, 1, 2, 3, 4]))
+	expect_eq(wasm.memory.compare(offset, offset + 2, 2), 0)
+	expect_eq(wasm.memory.compare(offset, offset + 4, 2), -1)
+	expect_eq(wasm.memory.compare(offset + 4, offset, 2), 1)
+	expect_eq(wasm.memory.find(make_bytes([2, 3, 4]), offset), offset + 3)
+	expect_eq(wasm.memory.find(make_bytes([4, 3, 2, 1]), offset), -1)
+	expect_empty()
+
+func test_invalid_memory_bulk_ops():
+	var wasm = load_wasm("memory")
+	var size = wasm.inspect().get("memory").get("current")
+	expect_eq(wasm.memory.fill(size - 4, 0, 8), ERR_PARAMETER_RANGE_ERROR)
+	expect_error("Memory access out of bounds")
+	expect_eq(wasm.memory.copy(0, size - 4, 8), ERR_PARAMETER_RANGE_ERROR)
+	expect_error("Memory access out of bounds")
+	expect_eq(wasm.memory.compare(0, size - 1, 2), -2)
+	expect_error("Memory access out of bounds")
+	expect_eq(WasmMemory.new().compare(0, 0, 0), -2)
+	expect_error("Invalid memory")
+	expect_eq(wasm.memory.find(make_bytes([1]), size + 1), -1)
+	expect_error("Memory access out of bounds")
+	expect_eq(wasm.memory.seek(size - 2).put_data(make_bytes([1, 2, 3, 4])), ERR_PARAMETER_RANGE_ERROR)
+	expect_error("Memory access out of bounds")
+
+func test_memory_image():
+	var wasm = load_wasm("memory")
+	var offset = wasm.global("offset")
+	wasm.memory.write_bytes(offset, make_bytes([0xFF, 0x00, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF]))
+	var image = wasm.memory.to_image(offset, 2, 1, Image.FORMAT_RGBA8)
+	expect_eq(image.get_size(), Vector2i(2, 1))
+	expect_eq(image.get_pixel(0, 0), Color.RED)
+	expect_eq(image.get_pixel(1, 0), Color.GREEN)
+	var texture = ImageTexture.create_from_image(Image.create(2, 1, false, Image.FORMAT_RGBA8))
+	expect_eq(wasm.memory.update_texture(texture, offset), OK)
+	expect_eq(wasm.memory.to_image(offset, 2, 1, Image.FORMAT_DXT1), null)
+	expect_error("Unsupported image format")
+
+func test_memory_mesh_arrays():
+	var wasm = load_wasm("memory")
+	var offset = wasm.global("offset")
+	var vertices = PackedVector3Array([Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0)])
+	var tangents = PackedFloat32Array([1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1])
+	var indices = PackedInt32Array([0, 2, 1])
+	wasm.memory.write_floats(offset, PackedFloat32Array([0, 0, 0, 1, 0, 0, 0, 1, 0])) # 32-bit floats regardless of precision
+	wasm.memory.write_floats(offset + 36, tangents)
+	wasm.memory.write_int32s(offset + 84, indices)
+	var layout = { Mesh.ARRAY_VERTEX: [offset, 3], Mesh.ARRAY_TANGENT: [offset + 36, 3], Mesh.ARRAY_INDEX: [offset + 84, 3] }
+	var arrays = wasm.memory.to_mesh_arrays(layout) # Counts are per vertex or index
+	expect_eq(arrays.size(), Mesh.ARRAY_MAX)
+	expect_eq(arrays[Mesh.ARRAY_VERTEX], vertices)
+	expect_eq(arrays[Mesh.ARRAY_TANGENT], tangents)
+	expect_eq(arrays[Mesh.ARRAY_INDEX], indices)
+	expect_eq(arrays[Mesh.ARRAY_NORMAL], null)
+	var mesh = ArrayMesh.new()
+	mesh.add_surface_from_arrays(Mesh.PRIMITIVE_TRIANGLES, arrays)
+	expect_eq(mesh.get_surface_count(), 1)
+	expect_empty()
+
 func test_memory_size():
 	# TODO: Available bytes always returns zero
 	var wasm = load_wasm("memory")
@@ -136,3 +233,63 @@ func test_resize():
 	wasm.function("resize", [PAGE_SIZE])
 	memory = wasm.inspect().get("memory").get("current")
 	expect_eq(memory, PAGE_SIZE * 3)
+
+func test_memory_grown_signal():
+	var wasm = load_wasm("memory")
+	var grown = []
+	wasm.memory.grown.connect(func(previous, pages): grown.append([previous, pages]))
+	wasm.function("resize", [PAGE_SIZE])
+	expect_eq(grown, [[1, 3]])
+	expect_eq(wasm.memory.grow(1), OK)
+	expect_eq(grown, [[1, 3], [3, 4]])
+
+func test_memory_growth_policy():
+	var memory = WasmMemory.new()
+	memory.maximum_pages = 16
+	memory.growth_factor = 2.0
+	var warnings = []
+	memory.limit_approaching.connect(func(pages, maximum): warnings.append([pages, maximum]))
+	expect_eq(memory.grow(2), OK)
+	expect_eq(memory.inspect().get("max"), PAGE_SIZE * 16)
+	expect_eq(memory.grow(1), OK) # Doubled
+	expect_eq(memory.inspect().get("current"), PAGE_SIZE * 4)
+	expect_eq(memory.reserve(15), OK)
+	expect_eq(memory.inspect().get("current"), PAGE_SIZE * 15)
+	expect_eq(warnings, [[15, 16]])
+	expect_eq(memory.grow(1), OK) # Capped by maximum
+	expect_eq(memory.inspect().get("current"), PAGE_SIZE * 16)
+	expect_eq(warnings, [[15, 16]]) # Once per crossing
+	expect_eq(memory.grow(1), FAILED)
+	expect_error("Memory limit exceeded")
+
+func test_snapshot_restore():
+	var wasm = load_wasm("memory")
+	var offset = wasm.global("offset")
+	var snapshot = wasm.snapshot()
+	expect(snapshot.has("memory"))
+	var original = wasm.function("load_byte", [0])
+	wasm.function("store_byte", [0xFF, 0])
+	wasm.function("resize", [PAGE_SIZE])
+	expect_eq(wasm.restore(snapshot), OK)
+	expect_eq(wasm.function("load_byte", [0]), original)
+	expect_eq(wasm.memory.read_bytes(PAGE_SIZE, 4), make_bytes([0, 0, 0, 0]))
+	expect_eq(wasm.global("offset"), offset)
+	expect_empty()
+
+func test_invalid_snapshot_restore():
+	var wasm = load_wasm("memory")
+	wasm.function("store_byte", [0xFF, 0])
+	var snapshot = wasm.snapshot()
+	var offset = wasm.global("offset")
+	# Invalid snapshots are rejected before any state is modified
+	expect_eq(wasm.restore({ "memory": [0, 0] }), ERR_INVALID_DATA)
+	expect_error("Invalid snapshot memory")
+	expect_eq(wasm.restore({ "memory": PackedByteArray(), "globals": { "asdf": 0 } }), ERR_INVALID_DATA)
+	expect_error("Unknown global name asdf")
+	var oversized = PackedByteArray()
+	oversized.resize(snapshot["memory"].size() + 1)
+	expect_eq(wasm.restore({ "memory": oversized }), ERR_PARAMETER_RANGE_ERROR)
+	expect_error("Snapshot larger than memory")
+	expect_eq(wasm.function("load_byte", [0]), 0xFF)
+	expect_eq(wasm.global("offset"), offset)
+	expect_empty()
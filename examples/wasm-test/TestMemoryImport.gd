@@ -89,3 +89,24 @@ func test_share_memory():
 	wasm_a.function("store_byte", [0xFF, 0])
 	var result = wasm_b.function("load_byte", [0])
 	expect_eq(result, 0xFF)
+
+func test_share_exported_memory():
+	# Memory exported by one instance imported by another
+	var wasm_a = load_wasm("memory")
+	expect_eq(wasm_a.memory.reserve(100), OK) # Satisfy import minimum
+	var wasm_b = load_wasm("memory-import", { "memory": wasm_a.memory })
+	expect(wasm_b.memory == wasm_a.memory)
+	wasm_a.function("store_byte", [0xAB, 0])
+	expect_eq(wasm_b.memory.seek(wasm_a.global("offset")).get_u8(), 0xAB)
+	# Memory outlives exporting instance
+	var memory = wasm_a.memory
+	wasm_a = null
+	memory.seek(wasm_b.global("offset")).put_u8(0xCD)
+	expect_eq(wasm_b.function("load_byte", [0]), 0xCD)
+	expect_empty()
+
+func test_invalid_memory_import_limits():
+	var memory = WasmMemory.new()
+	memory.grow(1)
+	load_wasm("memory-import", { "memory": memory }, ERR_CANT_CREATE)
+	expect_error("Import memory smaller than module minimum")
@@ -20,6 +20,15 @@ func test_proc_exit():
 	wasm.function("proc_exit", [1])
 	expect_error("Module exited with error 1")
 
+func test_proc_exit_resumable():
+	var wasm = load_wasm("wasi")
+	var call = wasm.function_resumable("proc_exit", [1])
+	while !call.resume(10): pass
+	expect_error("Module exited with error 1")
+	expect_eq(wasm.get_last_error(), OK)
+	expect_eq(wasm.function("fd_write", []), null)
+	expect_error("Not instantiated")
+
 func test_args_get():
 	var args = get_cmdline_user_args()
 	var wasm = load_wasm("wasi")
@@ -51,3 +60,60 @@ func test_disable_extension():
 	var error = wasm.load(buffer, {})
 	expect_eq(error, ERR_CANT_CREATE)
 	expect_error("Missing import function wasi_snapshot_preview1.args_get")
+
+func test_enable_extension():
+	# Extension imports are resolved on compilation irrespective of enabled extensions
+	var wasm = Wasm.new()
+	expect_eq(wasm.compile(read_file("wasi")), OK)
+	wasm.extensions = []
+	expect_eq(wasm.instantiate({}), ERR_CANT_CREATE)
+	expect_error("Missing import function wasi_snapshot_preview1.args_get")
+	wasm.extensions = ["wasi_preview1"]
+	expect_eq(wasm.instantiate({}), OK)
+	wasm.function("fd_write", [])
+	expect_log("Test fd_write")
+
+func test_fd_write_output():
+	var wasm = load_wasm("wasi")
+	var lines = []
+	wasm.output.connect(func(fd, text): lines.append([fd, text]))
+	wasm.print_output = false
+	wasm.function("fd_write", [])
+	expect_eq(lines, [[1, "Test fd_write"]])
+	expect_empty()
+
+func _path_open(wasm: Wasm, path: String, oflags: int = 0, rights: int = 2) -> int:
+	var bytes = path.to_utf8_buffer()
+	wasm.memory.seek(0).put_data(bytes)
+	return wasm.function("path_open", [3, 0, 0, bytes.size(), oflags, rights, rights, 0, 256])
+
+func test_path_open():
+	var wasm = load_wasm("wasi-fs")
+	expect_eq(_path_open(wasm, "wasm/simple.wasm"), 0)
+	var fd = wasm.memory.seek(256).get_32()
+	expect(fd > 4) # Follows standard streams and preopened directories
+	# Read header into guest memory via IO vector
+	wasm.memory.seek(272).put_32(512)
+	wasm.memory.seek(276).put_32(4)
+	expect_eq(wasm.function("fd_read", [fd, 272, 1, 280]), 0)
+	expect_eq(wasm.memory.seek(280).get_32(), 4)
+	expect_eq(wasm.memory.seek(512).get_data(4)[1], make_bytes([0x00, 0x61, 0x73, 0x6D]))
+	# Seek to end of file
+	expect_eq(wasm.function("fd_seek", [fd, 0, 2, 288]), 0)
+	expect_eq(wasm.memory.seek(288).get_64(), read_file("simple").size())
+	expect_eq(wasm.function("fd_read", [fd, 272, 1, 280]), 0)
+	expect_eq(wasm.memory.seek(280).get_32(), 0)
+	expect_eq(wasm.function("fd_close", [fd]), 0)
+	expect_eq(wasm.function("fd_close", [fd]), 8) # Bad file descriptor
+	expect_empty()
+
+func test_invalid_path_open():
+	var wasm = load_wasm("wasi-fs")
+	expect_eq(_path_open(wasm, "asdf"), 44) # No such file
+	expect_eq(_path_open(wasm, "../project.godot"), 76) # Escapes preopened directory
+	expect_eq(_path_open(wasm, "wasm/../../project.godot"), 76)
+	expect_eq(_path_open(wasm, "..\\project.godot"), 76)
+	expect_eq(_path_open(wasm, "C:/project.godot"), 76)
+	expect_eq(_path_open(wasm, "wasm/simple.wasm", 0, 2 | 64), 69) # Write rights on read-only filesystem
+	expect_eq(_path_open(wasm, "wasm/new.txt", 1), 69) # Create on read-only filesystem
+	expect_empty()
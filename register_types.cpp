@@ -1,6 +1,11 @@
 #include "register_types.h"
 #include "src/wasm.h"
 #include "src/wasm-memory.h"
+#include "src/wasm-function.h"
+#include "src/wasm-call.h"
+#include "src/wasm-module.h"
+#include "src/wasm-pool.h"
+#include "src/settings.h"
 
 using namespace godot;
 
@@ -11,6 +16,12 @@ void initialize_wasm_module(ModuleInitializationLevel p_level) {
 
   ClassDB::register_class<Wasm>();
   ClassDB::register_class<WasmMemory>();
+  ClassDB::register_class<WasmFunction>();
+  ClassDB::register_class<WasmCall>();
+  ClassDB::register_class<WasmModule>();
+  ClassDB::register_class<WasmPool>();
+
+  godot_wasm::settings::register_settings();
 }
 
 void uninitialize_wasm_module(ModuleInitializationLevel p_level) {
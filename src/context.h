@@ -0,0 +1,66 @@
+#ifndef GODOT_WASM_CONTEXT_H
+#define GODOT_WASM_CONTEXT_H
+
+/*
+Extern contexts
+Module import and export metadata; copied per instance to hold resolved handles and call state
+*/
+
+#include <vector>
+#include <wasm.h>
+#include "defs.h"
+
+namespace godot {
+  namespace godot_wasm {
+    struct ExtensionFunction;
+
+    struct ContextExtern {
+      uint16_t index; // Index within module imports/exports
+      ContextExtern(uint16_t i) { index = i; }
+    };
+
+    struct ContextFuncImport: public ContextExtern {
+      ObjectID object; // Resolved object method target; method name doesn't necessarily match import name
+      StringName method; // Resolved object method name
+      Callable target; // Resolved custom callable target e.g. lambda; empty for object method targets
+      const wasm_functype_t* func_type; // Non-owning; held by module
+      const ExtensionFunction* extension; // Fallback if import not provided; NULL if none
+      std::vector<wasm_valkind_t> results; // Return types
+      ContextFuncImport(uint16_t i, const wasm_functype_t* func_type, const ExtensionFunction* extension): ContextExtern(i), func_type(func_type), extension(extension) {
+        const wasm_valtype_vec_t* func_results = wasm_functype_results(func_type);
+        for (uint16_t i = 0; i < func_results->size; i++) results.push_back(wasm_valtype_kind(func_results->data[i]));
+      }
+    };
+
+    struct ContextGlobalExport: public ContextExtern {
+      const wasm_global_t* global; // Resolved on instantiation; owned by instance exports
+      ContextGlobalExport(uint16_t i): ContextExtern(i), global(NULL) {}
+    };
+
+    struct ContextFuncExport: public ContextExtern {
+      const wasm_func_t* func; // Resolved on instantiation; owned by instance exports
+      size_t return_count; // Number of return values
+      std::vector<wasm_valkind_t> params; // Param types
+      std::vector<wasm_valkind_t> returns; // Return types
+      mutable std::vector<wasm_val_t> args; // Argument scratch space reused between calls
+      mutable std::vector<wasm_val_t> results; // Result scratch space reused between calls
+      ContextFuncExport(uint16_t i, const wasm_functype_t* func_type): ContextExtern(i), func(NULL) {
+        const wasm_valtype_vec_t* func_params = wasm_functype_params(func_type);
+        const wasm_valtype_vec_t* func_results = wasm_functype_results(func_type);
+        for (uint16_t i = 0; i < func_params->size; i++) params.push_back(wasm_valtype_kind(func_params->data[i]));
+        for (uint16_t i = 0; i < func_results->size; i++) returns.push_back(wasm_valtype_kind(func_results->data[i]));
+        return_count = func_results->size;
+        args.resize(params.size());
+        results.resize(return_count);
+      }
+    };
+
+    struct ContextMemory: public ContextExtern {
+      bool import; // Import; not export
+      wasm_limits_t limits; // Declared limits in pages
+      ContextMemory(uint16_t i, bool import, const wasm_memorytype_t* memory_type): ContextExtern(i), import(import), limits(*wasm_memorytype_limits(memory_type)) {}
+    };
+  }
+}
+
+#endif
@@ -9,15 +9,32 @@ Useful for minimizing changes to implementation files between targets e.g. GDExt
 #ifdef GODOT_MODULE // Godot includes when building module
   #include <core/os/os.h>
   #include <core/os/time.h>
+  #include <core/os/thread.h>
   #include <core/crypto/crypto.h>
+  #include <core/crypto/hashing_context.h>
+  #include <core/io/file_access.h>
+  #include <core/io/dir_access.h>
+  #include <core/object/worker_thread_pool.h>
+  #include <core/config/project_settings.h>
   #include <core/io/stream_peer.h>
+  #include <core/io/image.h>
+  #include <scene/resources/image_texture.h>
+  #include <scene/resources/mesh.h>
   #include <core/variant/variant_utility.h>
 #else // Godot addon includes
   #include <godot_cpp/classes/ref_counted.hpp>
   #include <godot_cpp/classes/os.hpp>
   #include <godot_cpp/classes/time.hpp>
   #include <godot_cpp/classes/crypto.hpp>
+  #include <godot_cpp/classes/hashing_context.hpp>
+  #include <godot_cpp/classes/file_access.hpp>
+  #include <godot_cpp/classes/dir_access.hpp>
+  #include <godot_cpp/classes/worker_thread_pool.hpp>
+  #include <godot_cpp/classes/project_settings.hpp>
   #include <godot_cpp/classes/stream_peer_extension.hpp>
+  #include <godot_cpp/classes/image.hpp>
+  #include <godot_cpp/classes/image_texture.hpp>
+  #include <godot_cpp/classes/mesh.hpp>
   #include <godot_cpp/variant/utility_functions.hpp>
 #endif
 
@@ -29,6 +46,15 @@ Useful for minimizing changes to implementation files between targets e.g. GDExt
   #define INSTANCE_VALIDATE(o) (o.get_validated_object() != nullptr)
   #define REGISTRATION_METHOD _bind_methods
   #define RANDOM_BYTES(n) Crypto::create()->generate_random_bytes(n)
+  #define VARARG_SIGNATURE const Variant **p_args, int p_arg_count, Callable::CallError &r_error
+  #define THREAD_ID Thread::get_caller_id()
+  #define IS_MAIN_THREAD Thread::is_main_thread()
+  #define CALL_ERROR Callable::CallError
+  #define CALL_OK Callable::CallError::CALL_OK
+  #define CALL_ERROR_METHOD Callable::CallError::CALL_ERROR_INVALID_METHOD
+  #define CALL_ERROR_INSTANCE Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL
+  #define OBJECT_CALLP(object, method, args, count, ret, error) ret = (object)->callp(method, args, count, error)
+  #define CALLABLE_CALLP(callable, args, count, ret, error) (callable).callp(args, count, ret, error)
 #else
   #define PRINT(message) UtilityFunctions::print(String(message))
   #define PRINT_ERROR(message) _err_print_error(__FUNCTION__, __FILE__, __LINE__, "Godot Wasm: " + String(message))
@@ -37,6 +63,15 @@ Useful for minimizing changes to implementation files between targets e.g. GDExt
   #define INSTANCE_VALIDATE(o) (o.get_validated_object() != nullptr)
   #define REGISTRATION_METHOD _bind_methods
   #define RANDOM_BYTES(n) [n]()->PackedByteArray{Ref<Crypto> c;c.instantiate();return c->generate_random_bytes(n);}()
+  #define VARARG_SIGNATURE const Variant **p_args, GDExtensionInt p_arg_count, GDExtensionCallError &r_error
+  #define THREAD_ID OS::get_singleton()->get_thread_caller_id()
+  #define IS_MAIN_THREAD (OS::get_singleton()->get_thread_caller_id() == OS::get_singleton()->get_main_thread_id())
+  #define CALL_ERROR GDExtensionCallError
+  #define CALL_OK GDEXTENSION_CALL_OK
+  #define CALL_ERROR_METHOD GDEXTENSION_CALL_ERROR_INVALID_METHOD
+  #define CALL_ERROR_INSTANCE GDEXTENSION_CALL_ERROR_INSTANCE_IS_NULL
+  #define OBJECT_CALLP(object, method, args, count, ret, error) Variant(object).callp(method, args, count, ret, error)
+  #define CALLABLE_CALLP(callable, args, count, ret, error) [&]{static const StringName m("call");Variant(callable).callp(m, args, count, ret, error);}()
 #endif
 #define FAIL(message, ret) do { PRINT_ERROR(message); return ret; } while (0)
 #define FAIL_IF(cond, message, ret) if (unlikely(cond)) FAIL(message, ret)
@@ -47,6 +82,7 @@ Useful for minimizing changes to implementation files between targets e.g. GDExt
 #define TIME_REALTIME Time::get_singleton()->get_unix_time_from_system() * 1000000000
 #define TIME_MONOTONIC Time::get_singleton()->get_ticks_usec() * 1000
 #define NULL_VARIANT Variant()
+#define EMIT_SIGNAL_MAIN_THREAD(object, ...) do { if (IS_MAIN_THREAD) (object)->emit_signal(__VA_ARGS__); else (object)->call_deferred("emit_signal", __VA_ARGS__); } while (0)
 #define PAGE_SIZE 65536
 
 #endif
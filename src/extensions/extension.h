@@ -1,71 +1,90 @@
 #ifndef GODOT_WASM_EXTENSION_H
 #define GODOT_WASM_EXTENSION_H
 
-#include <map>
-#include <string>
-#include <vector>
+/*
+Extension host functions
+Extensions provide default/fallback imports e.g. WASI as static tables of host functions
+Imports are resolved against these tables once on module compilation; instantiation only creates the function handles
+*/
+
 #include <wasm.h>
 #include "../defs.h"
-#include "../defer.h"
-#include "../store.h"
 
 namespace godot {
   class Wasm; // Forward declare to avoid circular dependency
 
   namespace godot_wasm {
     typedef wasm_trap_t* (*extension_callback_t)(Wasm*, const wasm_val_vec_t*, wasm_val_vec_t*);
-    typedef std::tuple<std::vector<wasm_valkind_enum>, std::vector<wasm_valkind_enum>, extension_callback_t> callback_signature;
 
-    class Extension {
-      private:
-        Wasm* wasm; // Non-owning pointer to the Wasm instance
-        std::map<std::string, callback_signature> signatures;
+    // Extension bits within mask of enabled extensions; order matches extension_names
+    enum ExtensionId: uint32_t {
+      EXTENSION_WASI_PREVIEW_1 = 1 << 0,
+    };
 
-        wasm_func_t* create_callback(const callback_signature& signature) {
-          const auto& param_types = std::get<0>(signature);
-          const auto& result_types = std::get<1>(signature);
+    static const char* const extension_names[] = { "wasi_preview1" };
 
-          wasm_valtype_vec_t params;
-          wasm_valtype_vec_new_uninitialized(&params, param_types.size());
-          for (size_t i = 0; i < param_types.size(); i++) params.data[i] = wasm_valtype_new(param_types[i]);
-          DEFER(wasm_valtype_vec_delete(&params));
+    // Host function provided by an extension
+    struct ExtensionFunction {
+      const char* name; // Import key i.e. module.name
+      uint32_t extension; // Providing extension
+      const char* params; // Value types; one of i, I, f, F per i32, i64, f32, f64
+      const char* results;
+      extension_callback_t callback;
+    };
 
-          wasm_valtype_vec_t results;
-          wasm_valtype_vec_new_uninitialized(&results, result_types.size());
-          for (size_t i = 0; i < result_types.size(); i++) results.data[i] = wasm_valtype_new(result_types[i]);
-          DEFER(wasm_valtype_vec_delete(&results));
+    // Tables are sorted by import name to allow binary search; checked at compile time
+    constexpr int extension_compare(const char* a, const char* b) {
+      while (*a && *a == *b) a++, b++;
+      return (unsigned char)*a - (unsigned char)*b;
+    }
 
-          wasm_functype_t* functype = wasm_functype_new(&params, &results);
-          DEFER(wasm_functype_delete(functype));
+    template <size_t N> constexpr bool extension_sorted(const ExtensionFunction (&table)[N]) {
+      for (size_t i = 1; i < N; i++) if (extension_compare(table[i - 1].name, table[i].name) >= 0) return false;
+      return true;
+    }
 
-          extension_callback_t callback = std::get<2>(signature);
+    template <size_t N> const ExtensionFunction* extension_find(const ExtensionFunction (&table)[N], const char* name) {
+      size_t begin = 0, end = N;
+      while (begin < end) {
+        const size_t middle = (begin + end) / 2;
+        const int comparison = extension_compare(table[middle].name, name);
+        if (comparison == 0) return &table[middle];
+        if (comparison < 0) begin = middle + 1;
+        else end = middle;
+      }
+      return NULL;
+    }
 
-          return wasm_func_new_with_env(STORE, functype, (wasm_func_callback_with_env_t)callback, wasm, NULL);
+    inline bool extension_types_match(const char* kinds, const wasm_valtype_vec_t* types) {
+      for (size_t i = 0; i < types->size; i++, kinds++) {
+        switch (wasm_valtype_kind(types->data[i])) {
+          case WASM_I32: if (*kinds != 'i') return false; break;
+          case WASM_I64: if (*kinds != 'I') return false; break;
+          case WASM_F32: if (*kinds != 'f') return false; break;
+          case WASM_F64: if (*kinds != 'F') return false; break;
+          default: return false;
         }
+      }
+      return *kinds == '\0';
+    }
 
-      protected:
-        void register_callback(
-          const String& import_name,
-          const std::vector<wasm_valkind_enum>& param_types,
-          const std::vector<wasm_valkind_enum>& result_types,
-          extension_callback_t callback
-        ) {
-          std::string key = std::string(import_name.utf8().get_data());
-          signatures[key] = std::make_tuple(param_types, result_types, callback);
-        }
+    inline bool extension_signature_match(const ExtensionFunction* function, const wasm_functype_t* func_type) {
+      return extension_types_match(function->params, wasm_functype_params(func_type))
+        && extension_types_match(function->results, wasm_functype_results(func_type));
+    }
 
-      public:
-        Extension(Wasm* wasm_instance): wasm(wasm_instance) {}
-        virtual ~Extension() {}
+    inline uint32_t extension_mask(const PackedStringArray& extensions) {
+      uint32_t mask = 0;
+      for (uint32_t i = 0; i < sizeof(extension_names) / sizeof(*extension_names); i++) {
+        if (PACKED_ARRAY_HAS(extensions, extension_names[i])) mask |= 1 << i;
+      }
+      return mask;
+    }
 
-        virtual wasm_func_t* get_callback(const String &name) final {
-          std::string key = std::string(name.utf8().get_data());
-          if (signatures.count(key)) {
-            return create_callback(signatures[key]);
-          }
-          return NULL;
-        }
-    };
+    // Function type is that of the module import, which was matched against the extension signature on compilation
+    inline wasm_func_t* extension_callback(const ExtensionFunction* function, Wasm* wasm, wasm_store_t* store, const wasm_functype_t* func_type) {
+      return wasm_func_new_with_env(store, func_type, (wasm_func_callback_with_env_t)function->callback, wasm, NULL);
+    }
   }
 }
 
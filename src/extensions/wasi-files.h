@@ -0,0 +1,94 @@
+#ifndef GODOT_WASM_WASI_FILES_H
+#define GODOT_WASM_WASI_FILES_H
+
+/*
+WASI file descriptors
+Per instance descriptor table backing WASI Preview 1 filesystem functions
+Guests see the read-only preopened directories /res and /user mapped to res:// and user://
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include "../defs.h"
+
+#define WASI_READ_CHUNK 65536 // Bytes cached per file read where reads cannot target guest memory directly
+
+namespace godot {
+  namespace godot_wasm {
+    struct WasiFile {
+      String path; // Godot path e.g. res://data/file.txt
+      Ref<FileAccess> file; // Null for directories
+      String preopen; // Guest visible name of preopened directory; empty otherwise
+      #ifndef GODOT_MODULE
+        PackedByteArray cache; // Chunk of file at cache_offset; files are read-only so never stale
+        uint64_t cache_offset = 0;
+      #endif
+
+      // Read from current position e.g. directly into guest memory; returns bytes read
+      uint64_t read(uint8_t* buffer, uint64_t length) {
+        #ifdef GODOT_MODULE
+          return file->get_buffer(buffer, length);
+        #else
+          // godot-cpp only reads into new arrays so reads are served from a chunk cache, amortizing allocation
+          uint64_t position = file->get_position();
+          uint64_t total = 0;
+          while (total < length) {
+            if (position < cache_offset || position >= cache_offset + cache.size()) {
+              file->seek(position);
+              cache = file->get_buffer(std::max<uint64_t>(WASI_READ_CHUNK, length - total));
+              cache_offset = position;
+              if (cache.is_empty()) break; // End of file
+            }
+            const uint64_t available = std::min<uint64_t>(length - total, cache_offset + cache.size() - position);
+            memcpy(buffer + total, cache.ptr() + (position - cache_offset), available);
+            total += available;
+            position += available;
+          }
+          file->seek(position);
+          return total;
+        #endif
+      }
+    };
+
+    class WasiFiles {
+      private:
+        std::map<int32_t, WasiFile> files;
+        int32_t next; // Lowest candidate descriptor
+
+      public:
+        static const int32_t FIRST_FD = 3; // Following standard streams
+
+        WasiFiles() { reset(); }
+
+        // Close all files and restore preopened directories
+        void reset() {
+          files.clear();
+          files[FIRST_FD] = { "res://", Ref<FileAccess>(), "/res" };
+          files[FIRST_FD + 1] = { "user://", Ref<FileAccess>(), "/user" };
+          next = FIRST_FD + 2;
+        }
+
+        WasiFile* get(int32_t fd) {
+          const auto it = files.find(fd);
+          return it == files.end() ? NULL : &it->second;
+        }
+
+        int32_t open(const WasiFile& file) {
+          while (files.count(next)) next++;
+          files[next] = file;
+          return next++;
+        }
+
+        bool close(int32_t fd) {
+          const auto it = files.find(fd);
+          if (it == files.end()) return false;
+          files.erase(it);
+          if (fd < next) next = fd; // Reuse lowest descriptor as POSIX does
+          return true;
+        }
+    };
+  }
+}
+
+#endif
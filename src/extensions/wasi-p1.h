@@ -3,7 +3,6 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include "extension.h"
 #include "../wasm.h"
 #include "../defer.h"
@@ -13,8 +12,39 @@
 #define __WASI_CLOCKID_REALTIME (UINT32_C(0)) // The clock measuring real time
 #define __WASI_CLOCKID_MONOTONIC (UINT32_C(1)) // The store-wide monotonic clock
 #define __WASI_ERRNO_SUCCESS (UINT16_C(0)) // No error occurred
+#define __WASI_ERRNO_BADF (UINT16_C(8)) // Bad file descriptor
+#define __WASI_ERRNO_FAULT (UINT16_C(21)) // Bad address
 #define __WASI_ERRNO_INVAL (UINT16_C(28)) // Invalid argument
 #define __WASI_ERRNO_IO (UINT16_C(29)) // I/O error
+#define __WASI_ERRNO_ISDIR (UINT16_C(31)) // Is a directory
+#define __WASI_ERRNO_NOENT (UINT16_C(44)) // No such file or directory
+#define __WASI_ERRNO_NOTDIR (UINT16_C(54)) // Not a directory or a symbolic link to a directory
+#define __WASI_ERRNO_ROFS (UINT16_C(69)) // Read-only file system
+#define __WASI_ERRNO_SPIPE (UINT16_C(70)) // Invalid seek
+#define __WASI_ERRNO_NOTCAPABLE (UINT16_C(76)) // Extension: Capabilities insufficient
+#define __WASI_FILETYPE_CHARACTER_DEVICE (UINT8_C(2)) // The file descriptor or file refers to a character device inode
+#define __WASI_FILETYPE_DIRECTORY (UINT8_C(3)) // The file descriptor or file refers to a directory inode
+#define __WASI_FILETYPE_REGULAR_FILE (UINT8_C(4)) // The file descriptor or file refers to a regular file inode
+#define __WASI_WHENCE_SET (UINT8_C(0)) // Seek relative to start-of-file
+#define __WASI_WHENCE_CUR (UINT8_C(1)) // Seek relative to current position
+#define __WASI_WHENCE_END (UINT8_C(2)) // Seek relative to end-of-file
+#define __WASI_OFLAGS_CREAT (UINT16_C(1)) // Create file if it does not exist
+#define __WASI_OFLAGS_DIRECTORY (UINT16_C(2)) // Fail if not a directory
+#define __WASI_OFLAGS_EXCL (UINT16_C(4)) // Fail if file already exists
+#define __WASI_OFLAGS_TRUNC (UINT16_C(8)) // Truncate file to size 0
+#define __WASI_FDFLAGS_APPEND (UINT16_C(1)) // Append mode: Data written to the file is always appended to the file's end
+#define __WASI_RIGHTS_FD_READ (UINT64_C(1) << 1) // The right to invoke fd_read and sock_recv
+#define __WASI_RIGHTS_FD_SEEK (UINT64_C(1) << 2) // The right to invoke fd_seek
+#define __WASI_RIGHTS_FD_TELL (UINT64_C(1) << 5) // The right to invoke fd_tell
+#define __WASI_RIGHTS_FD_WRITE (UINT64_C(1) << 6) // The right to invoke fd_write and sock_send
+#define __WASI_RIGHTS_PATH_OPEN (UINT64_C(1) << 13) // The right to invoke path_open
+#define __WASI_RIGHTS_FD_READDIR (UINT64_C(1) << 14) // The right to invoke fd_readdir
+#define __WASI_RIGHTS_PATH_FILESTAT_GET (UINT64_C(1) << 18) // The right to invoke path_filestat_get
+#define __WASI_RIGHTS_FD_FILESTAT_GET (UINT64_C(1) << 21) // The right to invoke fd_filestat_get
+#define __WASI_PREOPENTYPE_DIR (UINT8_C(0)) // A pre-opened directory
+
+// Rights of read-only files and directories; filesystem is not writable
+#define WASI_RIGHTS_READ_ONLY (__WASI_RIGHTS_FD_READ | __WASI_RIGHTS_FD_SEEK | __WASI_RIGHTS_FD_TELL | __WASI_RIGHTS_PATH_OPEN | __WASI_RIGHTS_FD_READDIR | __WASI_RIGHTS_PATH_FILESTAT_GET | __WASI_RIGHTS_FD_FILESTAT_GET)
 
 namespace godot {
   namespace {
@@ -74,6 +104,51 @@ namespace godot {
       return wasm_trap_new(NULL, &trap_message);
     }
 
+    // Return WASI error number without trapping; expected by guests e.g. for missing files
+    wasm_trap_t* wasi_errno(wasm_val_vec_t* results, int32_t value) {
+      results->data[0].kind = WASM_I32;
+      results->data[0].of.i32 = value;
+      return NULL;
+    }
+
+    // Check that a guest memory range is within bounds
+    bool wasi_in_memory(wasm_memory_t* memory, uint32_t offset, uint64_t length) {
+      const uint64_t size = wasm_memory_data_size(memory);
+      return offset <= size && length <= size - offset;
+    }
+
+    // Resolve a guest path relative to a directory; fails if path escapes directory
+    bool wasi_resolve_path(const String& directory, const String& path, String& resolved) {
+      std::vector<String> components;
+      const auto parts = path.split("/");
+      for (auto i = 0; i < parts.size(); i++) {
+        const String part = parts[i];
+        if (part.is_empty() || part == ".") continue;
+        if (part.contains("\\") || part.contains(":")) return false; // Alternate separators or drives resolved by host
+        if (part != "..") components.push_back(part);
+        else if (components.empty()) return false;
+        else components.pop_back();
+      }
+      resolved = directory;
+      for (const auto &component: components) resolved += (resolved.ends_with("/") ? "" : "/") + component;
+      return true;
+    }
+
+    // Read from file directly into guest memory across IO vectors; stops at end of file
+    int32_t wasi_read_vectors(wasm_memory_t* memory, godot_wasm::WasiFile* file, uint32_t offset_iov, uint32_t count_iov, uint32_t* read) {
+      if (!wasi_in_memory(memory, offset_iov, (uint64_t)count_iov * sizeof(wasi_io_vector))) return __WASI_ERRNO_FAULT;
+      byte_t* data = wasm_memory_data(memory);
+      *read = 0;
+      for (uint32_t i = 0; i < count_iov; i++) {
+        wasi_io_vector iov = get_io_vector(memory, offset_iov, i);
+        if (!wasi_in_memory(memory, iov.offset, (uint32_t)iov.length)) return __WASI_ERRNO_FAULT;
+        const uint64_t length = file->read((uint8_t*)data + (uint32_t)iov.offset, (uint32_t)iov.length);
+        *read += length;
+        if (length < (uint32_t)iov.length) break;
+      }
+      return __WASI_ERRNO_SUCCESS;
+    }
+
     // WASI fd_write: [I32, I32, I32, I32] -> [I32]
     wasm_trap_t* wasi_fd_write(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
       FAIL_IF(args->size != 4 || results->size != 1, "Invalid arguments fd_write", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
@@ -81,26 +156,28 @@ namespace godot {
       if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
       byte_t* data = wasm_memory_data(memory);
       int32_t fd = args->data[0].of.i32;
-      int32_t offset_iov = args->data[1].of.i32;
-      int32_t count_iov = args->data[2].of.i32;
-      int32_t offset_written = args->data[3].of.i32;
+      uint32_t offset_iov = args->data[1].of.i32;
+      uint32_t count_iov = args->data[2].of.i32;
+      uint32_t offset_written = args->data[3].of.i32;
+      if (fd != 1 && fd != 2) return wasi_errno(results, __WASI_ERRNO_BADF); // Files are read-only
+      if (!wasi_in_memory(memory, offset_iov, (uint64_t)count_iov * sizeof(wasi_io_vector)) || !wasi_in_memory(memory, offset_written, sizeof(uint32_t))) {
+        return wasi_errno(results, __WASI_ERRNO_FAULT);
+      }
       uint32_t written = 0;
-      for (auto i = 0; i < count_iov; i++) {
+      for (uint32_t i = 0; i < count_iov; i++) {
         wasi_io_vector iov = get_io_vector(memory, offset_iov, i);
-        std::string message = std::string(data + iov.offset, data + iov.offset + iov.length);
-        if (iov.length == 1 && message == "\u000A") continue; // Skip line feed
-        fd == 1 ? PRINT(message.c_str()) : PRINT_ERROR(message.c_str());
+        if (!wasi_in_memory(memory, iov.offset, (uint32_t)iov.length)) return wasi_errno(results, __WASI_ERRNO_FAULT);
+        wasm->write_output(fd, (const char*)data + (uint32_t)iov.offset, (uint32_t)iov.length); // Buffered per line
         written += iov.length;
       }
-      memcpy(data + offset_written, &written, sizeof(int32_t));
+      memcpy(data + offset_written, &written, sizeof(uint32_t));
       return wasi_result(results);
     }
 
     // WASI proc_exit: [I32] -> []
     wasm_trap_t* wasi_proc_exit(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
       FAIL_IF(args->size != 1 || results->size != 0, "Invalid arguments proc_exit", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
-      wasm->exit(args->data[0].of.i32);
-      return NULL;
+      return wasm->exit(args->data[0].of.i32); // Trap unwinds guest call
     }
 
     // WASI args_sizes_get: [I32, I32] -> [I32]
@@ -182,46 +259,233 @@ namespace godot {
       return wasi_result(results);
     }
 
+    // WASI fd_prestat_get: [I32, I32] -> [I32]
+    wasm_trap_t* wasi_fd_prestat_get(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 2 || results->size != 1, "Invalid arguments fd_prestat_get", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      const godot_wasm::WasiFile* file = wasm->get_wasi_files().get(args->data[0].of.i32);
+      uint32_t offset = args->data[1].of.i32;
+      if (file == NULL || file->preopen.is_empty()) return wasi_errno(results, __WASI_ERRNO_BADF);
+      if (!wasi_in_memory(memory, offset, 8)) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      uint32_t length = file->preopen.utf8().length();
+      memset(data + offset, 0, 8);
+      data[offset] = __WASI_PREOPENTYPE_DIR;
+      memcpy(data + offset + 4, &length, sizeof(uint32_t));
+      return wasi_result(results);
+    }
+
+    // WASI fd_prestat_dir_name: [I32, I32, I32] -> [I32]
+    wasm_trap_t* wasi_fd_prestat_dir_name(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 3 || results->size != 1, "Invalid arguments fd_prestat_dir_name", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      const godot_wasm::WasiFile* file = wasm->get_wasi_files().get(args->data[0].of.i32);
+      uint32_t offset = args->data[1].of.i32;
+      uint32_t length = args->data[2].of.i32;
+      if (file == NULL || file->preopen.is_empty()) return wasi_errno(results, __WASI_ERRNO_BADF);
+      const CharString name = file->preopen.utf8();
+      if (length < (uint32_t)name.length()) return wasi_errno(results, __WASI_ERRNO_INVAL);
+      if (!wasi_in_memory(memory, offset, name.length())) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      memcpy(data + offset, name.get_data(), name.length()); // Not null terminated
+      return wasi_result(results);
+    }
+
+    // WASI path_open: [I32, I32, I32, I32, I32, I64, I64, I32, I32] -> [I32]
+    wasm_trap_t* wasi_path_open(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 9 || results->size != 1, "Invalid arguments path_open", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      godot_wasm::WasiFiles& files = wasm->get_wasi_files();
+      const godot_wasm::WasiFile* directory = files.get(args->data[0].of.i32);
+      uint32_t offset_path = args->data[2].of.i32;
+      uint32_t length_path = args->data[3].of.i32;
+      uint32_t oflags = args->data[4].of.i32;
+      uint64_t rights = args->data[5].of.i64;
+      uint32_t fdflags = args->data[7].of.i32;
+      uint32_t offset_fd = args->data[8].of.i32;
+      if (directory == NULL) return wasi_errno(results, __WASI_ERRNO_BADF);
+      if (directory->file.is_valid()) return wasi_errno(results, __WASI_ERRNO_NOTDIR);
+      if (!wasi_in_memory(memory, offset_path, length_path) || !wasi_in_memory(memory, offset_fd, sizeof(int32_t))) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      if ((oflags & (__WASI_OFLAGS_CREAT | __WASI_OFLAGS_EXCL | __WASI_OFLAGS_TRUNC)) || (rights & __WASI_RIGHTS_FD_WRITE) || (fdflags & __WASI_FDFLAGS_APPEND)) {
+        return wasi_errno(results, __WASI_ERRNO_ROFS);
+      }
+      godot_wasm::WasiFile file;
+      if (!wasi_resolve_path(directory->path, String::utf8((const char*)data + offset_path, length_path), file.path)) {
+        return wasi_errno(results, __WASI_ERRNO_NOTCAPABLE);
+      }
+      if (!DirAccess::dir_exists_absolute(file.path)) {
+        if (oflags & __WASI_OFLAGS_DIRECTORY) return wasi_errno(results, FileAccess::file_exists(file.path) ? __WASI_ERRNO_NOTDIR : __WASI_ERRNO_NOENT);
+        file.file = FileAccess::open(file.path, FileAccess::READ);
+        if (file.file.is_null()) return wasi_errno(results, __WASI_ERRNO_NOENT);
+      }
+      int32_t fd = files.open(file);
+      memcpy(data + offset_fd, &fd, sizeof(int32_t));
+      return wasi_result(results);
+    }
+
+    // WASI fd_read: [I32, I32, I32, I32] -> [I32]
+    wasm_trap_t* wasi_fd_read(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 4 || results->size != 1, "Invalid arguments fd_read", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      int32_t fd = args->data[0].of.i32;
+      uint32_t offset_read = args->data[3].of.i32;
+      uint32_t read = 0;
+      if (!wasi_in_memory(memory, offset_read, sizeof(uint32_t))) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      if (fd != 0) { // Standard input is always empty
+        godot_wasm::WasiFile* file = wasm->get_wasi_files().get(fd);
+        if (file == NULL) return wasi_errno(results, __WASI_ERRNO_BADF);
+        if (file->file.is_null()) return wasi_errno(results, __WASI_ERRNO_ISDIR);
+        int32_t error = wasi_read_vectors(memory, file, args->data[1].of.i32, args->data[2].of.i32, &read);
+        if (error != __WASI_ERRNO_SUCCESS) return wasi_errno(results, error);
+      }
+      memcpy(data + offset_read, &read, sizeof(uint32_t));
+      return wasi_result(results);
+    }
+
+    // WASI fd_pread: [I32, I32, I32, I64, I32] -> [I32]
+    wasm_trap_t* wasi_fd_pread(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 5 || results->size != 1, "Invalid arguments fd_pread", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      int32_t fd = args->data[0].of.i32;
+      uint64_t offset = args->data[3].of.i64;
+      uint32_t offset_read = args->data[4].of.i32;
+      godot_wasm::WasiFile* file = wasm->get_wasi_files().get(fd);
+      if (fd >= 0 && fd < godot_wasm::WasiFiles::FIRST_FD) return wasi_errno(results, __WASI_ERRNO_SPIPE);
+      if (file == NULL) return wasi_errno(results, __WASI_ERRNO_BADF);
+      if (file->file.is_null()) return wasi_errno(results, __WASI_ERRNO_ISDIR);
+      if (!wasi_in_memory(memory, offset_read, sizeof(uint32_t))) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      // Positional read leaves file position unchanged
+      uint64_t position = file->file->get_position();
+      uint32_t read = 0;
+      file->file->seek(offset);
+      int32_t error = wasi_read_vectors(memory, file, args->data[1].of.i32, args->data[2].of.i32, &read);
+      file->file->seek(position);
+      if (error != __WASI_ERRNO_SUCCESS) return wasi_errno(results, error);
+      memcpy(data + offset_read, &read, sizeof(uint32_t));
+      return wasi_result(results);
+    }
+
+    // WASI fd_seek: [I32, I64, I32, I32] -> [I32]
+    wasm_trap_t* wasi_fd_seek(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 4 || results->size != 1, "Invalid arguments fd_seek", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      int32_t fd = args->data[0].of.i32;
+      int64_t offset = args->data[1].of.i64;
+      uint32_t offset_position = args->data[3].of.i32;
+      const godot_wasm::WasiFile* file = wasm->get_wasi_files().get(fd);
+      if (fd >= 0 && fd < godot_wasm::WasiFiles::FIRST_FD) return wasi_errno(results, __WASI_ERRNO_SPIPE);
+      if (file == NULL) return wasi_errno(results, __WASI_ERRNO_BADF);
+      if (file->file.is_null()) return wasi_errno(results, __WASI_ERRNO_ISDIR);
+      if (!wasi_in_memory(memory, offset_position, sizeof(uint64_t))) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      int64_t position;
+      switch (args->data[2].of.i32) {
+        case __WASI_WHENCE_SET: position = offset; break;
+        case __WASI_WHENCE_CUR: position = file->file->get_position() + offset; break;
+        case __WASI_WHENCE_END: position = file->file->get_length() + offset; break;
+        default: return wasi_errno(results, __WASI_ERRNO_INVAL);
+      }
+      if (position < 0) return wasi_errno(results, __WASI_ERRNO_INVAL);
+      file->file->seek(position);
+      memcpy(data + offset_position, &position, sizeof(uint64_t));
+      return wasi_result(results);
+    }
+
+    // WASI fd_close: [I32] -> [I32]
+    wasm_trap_t* wasi_fd_close(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 1 || results->size != 1, "Invalid arguments fd_close", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      int32_t fd = args->data[0].of.i32;
+      if (fd >= 0 && fd < godot_wasm::WasiFiles::FIRST_FD) return wasi_result(results); // Standard streams remain open
+      return wasi_errno(results, wasm->get_wasi_files().close(fd) ? __WASI_ERRNO_SUCCESS : __WASI_ERRNO_BADF);
+    }
+
+    // WASI fd_fdstat_get: [I32, I32] -> [I32]
+    wasm_trap_t* wasi_fd_fdstat_get(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 2 || results->size != 1, "Invalid arguments fd_fdstat_get", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      int32_t fd = args->data[0].of.i32;
+      uint32_t offset = args->data[1].of.i32;
+      const godot_wasm::WasiFile* file = wasm->get_wasi_files().get(fd);
+      if (!wasi_in_memory(memory, offset, 24)) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      uint8_t type;
+      uint64_t rights;
+      if (fd >= 0 && fd < godot_wasm::WasiFiles::FIRST_FD) {
+        type = __WASI_FILETYPE_CHARACTER_DEVICE;
+        rights = fd == 0 ? __WASI_RIGHTS_FD_READ : __WASI_RIGHTS_FD_WRITE;
+      } else if (file != NULL) {
+        type = file->file.is_valid() ? __WASI_FILETYPE_REGULAR_FILE : __WASI_FILETYPE_DIRECTORY;
+        rights = WASI_RIGHTS_READ_ONLY;
+      } else return wasi_errno(results, __WASI_ERRNO_BADF);
+      memset(data + offset, 0, 24);
+      data[offset] = type;
+      memcpy(data + offset + 8, &rights, sizeof(uint64_t)); // Base rights
+      memcpy(data + offset + 16, &rights, sizeof(uint64_t)); // Inheriting rights
+      return wasi_result(results);
+    }
+
+    // WASI fd_filestat_get: [I32, I32] -> [I32]
+    wasm_trap_t* wasi_fd_filestat_get(Wasm* wasm, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      FAIL_IF(args->size != 2 || results->size != 1, "Invalid arguments fd_filestat_get", wasi_result(results, __WASI_ERRNO_INVAL, "Invalid arguments\0"));
+      wasm_memory_t* memory = wasm->get_memory().ptr()->get_memory();
+      if (memory == NULL) return wasi_result(results, __WASI_ERRNO_IO, "Invalid memory\0");
+      byte_t* data = wasm_memory_data(memory);
+      int32_t fd = args->data[0].of.i32;
+      uint32_t offset = args->data[1].of.i32;
+      const godot_wasm::WasiFile* file = wasm->get_wasi_files().get(fd);
+      if (!wasi_in_memory(memory, offset, 64)) return wasi_errno(results, __WASI_ERRNO_FAULT);
+      uint64_t size = 0;
+      uint64_t time = 0;
+      memset(data + offset, 0, 64);
+      if (fd >= 0 && fd < godot_wasm::WasiFiles::FIRST_FD) {
+        data[offset + 16] = __WASI_FILETYPE_CHARACTER_DEVICE;
+      } else if (file != NULL) {
+        data[offset + 16] = file->file.is_valid() ? __WASI_FILETYPE_REGULAR_FILE : __WASI_FILETYPE_DIRECTORY;
+        if (file->file.is_valid()) {
+          size = file->file->get_length();
+          time = FileAccess::get_modified_time(file->path) * 1000000000; // Seconds to nanoseconds
+        }
+      } else return wasi_errno(results, __WASI_ERRNO_BADF);
+      uint64_t links = 1;
+      memcpy(data + offset + 24, &links, sizeof(uint64_t));
+      memcpy(data + offset + 32, &size, sizeof(uint64_t));
+      for (auto i = 0; i < 3; i++) memcpy(data + offset + 40 + i * 8, &time, sizeof(uint64_t)); // Access, modification, status change
+      return wasi_result(results);
+    }
   }
 
   namespace godot_wasm {
-    class WasiPreview1Extension: public Extension {
-      public:
-        WasiPreview1Extension(Wasm* wasm): Extension(wasm) {
-          register_callback("wasi_snapshot_preview1.fd_write",
-            {WASM_I32, WASM_I32, WASM_I32, WASM_I32},
-            {WASM_I32},
-            wasi_fd_write);
-          register_callback("wasi_snapshot_preview1.proc_exit",
-            {WASM_I32},
-            {},
-            wasi_proc_exit);
-          register_callback("wasi_snapshot_preview1.args_sizes_get",
-            {WASM_I32, WASM_I32},
-            {WASM_I32},
-            wasi_args_sizes_get);
-          register_callback("wasi_snapshot_preview1.args_get",
-            {WASM_I32, WASM_I32},
-            {WASM_I32},
-            wasi_args_get);
-          register_callback("wasi_snapshot_preview1.environ_sizes_get",
-            {WASM_I32, WASM_I32},
-            {WASM_I32},
-            wasi_environ_sizes_get);
-          register_callback("wasi_snapshot_preview1.environ_get",
-            {WASM_I32, WASM_I32},
-            {WASM_I32},
-            wasi_environ_get);
-          register_callback("wasi_snapshot_preview1.random_get",
-            {WASM_I32, WASM_I32},
-            {WASM_I32},
-            wasi_random_get);
-          register_callback("wasi_snapshot_preview1.clock_time_get",
-            {WASM_I32, WASM_I64, WASM_I32},
-            {WASM_I32},
-            wasi_clock_time_get);
-        }
+    // Sorted by import name
+    static constexpr ExtensionFunction wasi_preview1_functions[] = {
+      { "wasi_snapshot_preview1.args_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_args_get },
+      { "wasi_snapshot_preview1.args_sizes_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_args_sizes_get },
+      { "wasi_snapshot_preview1.clock_time_get", EXTENSION_WASI_PREVIEW_1, "iIi", "i", wasi_clock_time_get },
+      { "wasi_snapshot_preview1.environ_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_environ_get },
+      { "wasi_snapshot_preview1.environ_sizes_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_environ_sizes_get },
+      { "wasi_snapshot_preview1.fd_close", EXTENSION_WASI_PREVIEW_1, "i", "i", wasi_fd_close },
+      { "wasi_snapshot_preview1.fd_fdstat_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_fd_fdstat_get },
+      { "wasi_snapshot_preview1.fd_filestat_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_fd_filestat_get },
+      { "wasi_snapshot_preview1.fd_pread", EXTENSION_WASI_PREVIEW_1, "iiiIi", "i", wasi_fd_pread },
+      { "wasi_snapshot_preview1.fd_prestat_dir_name", EXTENSION_WASI_PREVIEW_1, "iii", "i", wasi_fd_prestat_dir_name },
+      { "wasi_snapshot_preview1.fd_prestat_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_fd_prestat_get },
+      { "wasi_snapshot_preview1.fd_read", EXTENSION_WASI_PREVIEW_1, "iiii", "i", wasi_fd_read },
+      { "wasi_snapshot_preview1.fd_seek", EXTENSION_WASI_PREVIEW_1, "iIii", "i", wasi_fd_seek },
+      { "wasi_snapshot_preview1.fd_write", EXTENSION_WASI_PREVIEW_1, "iiii", "i", wasi_fd_write },
+      { "wasi_snapshot_preview1.path_open", EXTENSION_WASI_PREVIEW_1, "iiiiiIIii", "i", wasi_path_open },
+      { "wasi_snapshot_preview1.proc_exit", EXTENSION_WASI_PREVIEW_1, "i", "", wasi_proc_exit },
+      { "wasi_snapshot_preview1.random_get", EXTENSION_WASI_PREVIEW_1, "ii", "i", wasi_random_get },
     };
+    static_assert(extension_sorted(wasi_preview1_functions), "WASI Preview 1 functions must be sorted by name");
   }
 }
 
@@ -0,0 +1,385 @@
+#include <cstring>
+#include "preinitializer.h"
+
+#define SECTION_CUSTOM 0
+#define SECTION_IMPORT 2
+#define SECTION_MEMORY 5
+#define SECTION_GLOBAL 6
+#define SECTION_EXPORT 7
+#define SECTION_START 8
+#define SECTION_CODE 10
+#define SECTION_DATA 11
+#define SECTION_DATA_COUNT 12
+#define EXTERN_FUNC 0
+#define EXTERN_TABLE 1
+#define EXTERN_MEMORY 2
+#define EXTERN_GLOBAL 3
+#define EXTERN_TAG 4
+#define SEGMENT_GAP 32 // Zero bytes tolerated within a data segment before splitting
+#define EXPORT_PREFIX "__godot_wasm_"
+
+namespace godot {
+  namespace {
+    // Bounds checked reader of Wasm binary encoding; invalid once a read fails
+    struct Reader {
+      const uint8_t* data;
+      size_t pos;
+      size_t end;
+      bool ok;
+
+      Reader(const uint8_t* data, size_t pos, size_t end): data(data), pos(pos), end(end), ok(true) {}
+
+      uint8_t byte() {
+        if (pos >= end) {
+          ok = false;
+          return 0;
+        }
+        return data[pos++];
+      }
+
+      uint64_t uleb() {
+        // Also skips signed values as continuation bits are identical
+        uint64_t result = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+          const uint8_t b = byte();
+          result |= (uint64_t)(b & 0x7F) << shift;
+          if (!(b & 0x80)) return result;
+        }
+        ok = false;
+        return 0;
+      }
+
+      void skip(size_t bytes) {
+        if (end - pos < bytes) ok = false;
+        pos = ok ? pos + bytes : end;
+      }
+
+      String name() {
+        const size_t length = uleb();
+        const size_t begin = pos;
+        skip(length);
+        return ok ? String::utf8((const char*)data + begin, length) : String();
+      }
+
+      void value_type() {
+        const uint8_t type = byte();
+        if (type == 0x63 || type == 0x64) uleb(); // Typed reference heap type
+      }
+
+      void limits() {
+        const uint8_t flags = byte();
+        uleb();
+        if (flags & 1) uleb();
+      }
+
+      void expression() {
+        // Constant expressions; extended constant arithmetic has no immediates
+        while (ok) {
+          switch (byte()) {
+            case 0x0B: return; // End
+            case 0x41: case 0x42: case 0x23: case 0xD2: uleb(); break; // Constants, global.get, ref.func
+            case 0x43: skip(4); break;
+            case 0x44: skip(8); break;
+            case 0xD0: value_type(); break; // ref.null
+            case 0xFD: uleb(); skip(16); break; // v128.const
+            default: break;
+          }
+        }
+      }
+    };
+
+    void write_uleb(std::vector<uint8_t>& buffer, uint64_t value) {
+      do {
+        uint8_t b = value & 0x7F;
+        value >>= 7;
+        buffer.push_back(value ? b | 0x80 : b);
+      } while (value);
+    }
+
+    void write_sleb(std::vector<uint8_t>& buffer, int64_t value) {
+      while (true) {
+        const uint8_t b = value & 0x7F;
+        value >>= 7; // Arithmetic shift
+        if ((value == 0 && !(b & 0x40)) || (value == -1 && (b & 0x40))) {
+          buffer.push_back(b);
+          return;
+        }
+        buffer.push_back(b | 0x80);
+      }
+    }
+
+    void write_bytes(std::vector<uint8_t>& buffer, const uint8_t* data, size_t length) {
+      buffer.insert(buffer.end(), data, data + length);
+    }
+
+    void write_name(std::vector<uint8_t>& buffer, const String& name) {
+      const CharString utf8 = name.utf8();
+      write_uleb(buffer, utf8.length());
+      write_bytes(buffer, (const uint8_t*)utf8.get_data(), utf8.length());
+    }
+
+    void write_const(std::vector<uint8_t>& buffer, const wasm_val_t& value) {
+      switch (value.kind) {
+        case WASM_I32: buffer.push_back(0x41); write_sleb(buffer, value.of.i32); break;
+        case WASM_I64: buffer.push_back(0x42); write_sleb(buffer, value.of.i64); break;
+        case WASM_F32: buffer.push_back(0x43); write_bytes(buffer, (const uint8_t*)&value.of.f32, 4); break;
+        case WASM_F64: buffer.push_back(0x44); write_bytes(buffer, (const uint8_t*)&value.of.f64, 8); break;
+        default: break;
+      }
+      buffer.push_back(0x0B);
+    }
+
+    // Canonical order of non-custom sections; data count precedes code
+    int section_rank(uint8_t id) {
+      static const uint8_t order[] = { 1, 2, 3, 4, 5, 13, 6, 7, 8, 9, 12, 10, 11 };
+      for (int i = 0; i < (int)sizeof(order); i++) if (order[i] == id) return i;
+      return -1;
+    }
+  }
+
+  namespace godot_wasm {
+    String Preinitializer::global_name(uint32_t index) {
+      return EXPORT_PREFIX "global_" + String::num_int64(index);
+    }
+
+    const Preinitializer::Section* Preinitializer::find_section(uint8_t id) const {
+      for (const auto &section: sections) if (section.id == id) return &section;
+      return NULL;
+    }
+
+    godot_error Preinitializer::parse(const PackedByteArray& bytecode_new) {
+      bytecode = bytecode_new;
+      const uint8_t* data = bytecode.ptr();
+      const size_t size = bytecode.size();
+      static const uint8_t header[] = { 0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00 };
+      FAIL_IF(size < sizeof(header) || memcmp(data, header, sizeof(header)), "Invalid module header", ERR_INVALID_DATA);
+
+      Reader reader(data, sizeof(header), size);
+      while (reader.ok && reader.pos < size) {
+        const uint8_t id = reader.byte();
+        const size_t length = reader.uleb();
+        FAIL_IF(!reader.ok || size - reader.pos < length, "Invalid module section", ERR_INVALID_DATA);
+        const Range content = { reader.pos, reader.pos + length };
+        sections.push_back({ id, content });
+        reader.pos = content.end;
+
+        Reader section(data, content.begin, content.end);
+        switch (id) {
+          case SECTION_IMPORT: {
+            for (uint64_t count = section.uleb(); count && section.ok; count--) {
+              section.name();
+              section.name();
+              switch (section.byte()) {
+                case EXTERN_FUNC: section.uleb(); break;
+                case EXTERN_TABLE: section.value_type(); section.limits(); break;
+                case EXTERN_MEMORY: FAIL("Imported memory unsupported", ERR_UNAVAILABLE);
+                case EXTERN_GLOBAL: section.value_type(); section.byte(); imported_globals++; break;
+                case EXTERN_TAG: section.byte(); section.uleb(); break;
+                default: FAIL("Invalid import kind", ERR_INVALID_DATA);
+              }
+            }
+            break;
+          } case SECTION_MEMORY: {
+            const uint64_t count = section.uleb();
+            FAIL_IF(count > 1, "Multiple memories unsupported", ERR_UNAVAILABLE);
+            if (count == 0) break;
+            has_memory = true;
+            memory_flags = section.byte();
+            FAIL_IF(memory_flags > 1, "Shared or 64-bit memory unsupported", ERR_UNAVAILABLE);
+            memory_min = section.uleb();
+            if (memory_flags & 1) memory_max = section.uleb();
+            break;
+          } case SECTION_GLOBAL: {
+            const uint64_t count = section.uleb();
+            for (uint64_t i = 0; i < count && section.ok; i++) {
+              GlobalEntry entry;
+              entry.type.begin = section.pos;
+              const uint8_t type = section.byte();
+              if (type == 0x63 || type == 0x64) section.uleb(); // Typed reference heap type
+              const bool variable = section.byte() == 1;
+              entry.type.end = entry.init.begin = section.pos;
+              section.expression();
+              entry.init.end = section.pos;
+              entry.tracked = -1;
+              wasm_valkind_t kind;
+              switch (type) {
+                case 0x7F: kind = WASM_I32; break;
+                case 0x7E: kind = WASM_I64; break;
+                case 0x7D: kind = WASM_F32; break;
+                case 0x7C: kind = WASM_F64; break;
+                default: kind = WASM_EXTERNREF; // Reference or vector; immutable ones retain their initializer
+              }
+              FAIL_IF(variable && kind == WASM_EXTERNREF, "Mutable reference or vector globals unsupported", ERR_UNAVAILABLE);
+              if (variable) {
+                entry.tracked = globals.size();
+                globals.push_back({ (uint32_t)(imported_globals + i), kind });
+              }
+              global_entries.push_back(entry);
+            }
+            break;
+          } case SECTION_EXPORT: {
+            for (uint64_t count = section.uleb(); count && section.ok; count--) {
+              ExportEntry entry;
+              entry.bytes.begin = section.pos;
+              entry.name = section.name();
+              entry.kind = section.byte();
+              section.uleb();
+              entry.bytes.end = section.pos;
+              if (entry.kind == EXTERN_MEMORY) memory_exported = true;
+              exports.push_back(entry);
+            }
+            break;
+          }
+          case SECTION_START: FAIL("Start function unsupported", ERR_UNAVAILABLE);
+          default: break;
+        }
+        FAIL_IF(!section.ok, "Invalid module section", ERR_INVALID_DATA);
+      }
+      FAIL_IF(!reader.ok, "Invalid module", ERR_INVALID_DATA);
+      return OK;
+    }
+
+    PackedByteArray Preinitializer::rebuild(const std::map<uint8_t, Buffer>& replacements) const {
+      // Copy sections, substituting replacements and inserting those absent from the original in canonical order
+      Buffer module(bytecode.ptr(), bytecode.ptr() + 8);
+      std::map<uint8_t, Buffer> pending = replacements;
+      const auto emit = [&](uint8_t id, const uint8_t* content, size_t length) {
+        module.push_back(id);
+        write_uleb(module, length);
+        write_bytes(module, content, length);
+      };
+      const auto flush = [&](int rank) {
+        for (auto it = pending.begin(); it != pending.end();) {
+          if (section_rank(it->first) >= rank) {
+            it++;
+            continue;
+          }
+          emit(it->first, it->second.data(), it->second.size());
+          it = pending.erase(it);
+        }
+      };
+      for (const auto &section: sections) {
+        if (section.id != SECTION_CUSTOM) flush(section_rank(section.id));
+        const auto it = pending.find(section.id);
+        if (section.id != SECTION_CUSTOM && it != pending.end()) {
+          emit(section.id, it->second.data(), it->second.size());
+          pending.erase(it);
+        } else {
+          emit(section.id, bytecode.ptr() + section.content.begin, section.content.end - section.content.begin);
+        }
+      }
+      flush(section_rank(SECTION_DATA) + 1);
+
+      PackedByteArray result;
+      result.resize(module.size());
+      memcpy(result.ptrw(), module.data(), module.size());
+      return result;
+    }
+
+    PackedByteArray Preinitializer::instrument() const {
+      // Export mutable globals and memory such that their initialized values can be read
+      Buffer section;
+      write_uleb(section, exports.size() + globals.size() + (has_memory && !memory_exported));
+      for (const auto &entry: exports) write_bytes(section, bytecode.ptr() + entry.bytes.begin, entry.bytes.end - entry.bytes.begin);
+      for (const auto &global: globals) {
+        write_name(section, global_name(global.index));
+        section.push_back(EXTERN_GLOBAL);
+        write_uleb(section, global.index);
+      }
+      if (has_memory && !memory_exported) {
+        write_name(section, EXPORT_PREFIX "memory");
+        section.push_back(EXTERN_MEMORY);
+        write_uleb(section, 0);
+      }
+      return rebuild({ { SECTION_EXPORT, section } });
+    }
+
+    PackedByteArray Preinitializer::bake(const std::vector<wasm_val_t>& values, const PackedByteArray& memory) const {
+      FAIL_IF(values.size() != globals.size(), "Invalid global values", PackedByteArray());
+      std::map<uint8_t, Buffer> replacements;
+      const uint8_t* data = bytecode.ptr();
+
+      // Global initializers replaced by initialized values
+      if (!global_entries.empty()) {
+        Buffer& section = replacements[SECTION_GLOBAL];
+        write_uleb(section, global_entries.size());
+        for (const auto &entry: global_entries) {
+          write_bytes(section, data + entry.type.begin, entry.type.end - entry.type.begin);
+          if (entry.tracked >= 0) write_const(section, values[entry.tracked]);
+          else write_bytes(section, data + entry.init.begin, entry.init.end - entry.init.begin);
+        }
+      }
+
+      // Initializer export removed so that instantiation skips initialization
+      Buffer& export_section = replacements[SECTION_EXPORT];
+      uint32_t export_count = 0;
+      Buffer export_entries;
+      for (const auto &entry: exports) {
+        if (entry.kind == EXTERN_FUNC && entry.name == "_initialize") continue;
+        write_bytes(export_entries, data + entry.bytes.begin, entry.bytes.end - entry.bytes.begin);
+        export_count++;
+      }
+      write_uleb(export_section, export_count);
+      write_bytes(export_section, export_entries.data(), export_entries.size());
+
+      if (!has_memory) return rebuild(replacements);
+
+      // Memory minimum covers memory grown during initialization
+      const uint64_t pages = memory.size() / PAGE_SIZE;
+      Buffer& memory_section = replacements[SECTION_MEMORY];
+      write_uleb(memory_section, 1);
+      memory_section.push_back(memory_flags);
+      write_uleb(memory_section, pages > memory_min ? pages : memory_min);
+      if (memory_flags & 1) write_uleb(memory_section, memory_max);
+
+      // Segments are emptied rather than removed to preserve segment indices referenced by code
+      // Passive segment contents are consumed by initialization and baked into memory; an empty segment matches a dropped one
+      Buffer segments;
+      uint64_t segment_count = 0;
+      const Section* data_section = find_section(SECTION_DATA);
+      if (data_section) {
+        Reader reader(data, data_section->content.begin, data_section->content.end);
+        for (uint64_t count = reader.uleb(); count && reader.ok; count--) {
+          const size_t begin = reader.pos;
+          const uint64_t flags = reader.uleb();
+          if (flags == 2) reader.uleb(); // Memory index
+          if (flags != 1) reader.expression();
+          const size_t header_end = reader.pos;
+          const size_t length = reader.uleb();
+          reader.skip(length);
+          write_bytes(segments, data + begin, header_end - begin);
+          write_uleb(segments, 0);
+          segment_count++;
+        }
+        FAIL_IF(!reader.ok, "Invalid data section", PackedByteArray());
+      }
+
+      // Initialized memory split into segments around runs of zeros; memory is otherwise zero initialized
+      const uint8_t* bytes = memory.ptr();
+      const size_t size = memory.size();
+      for (size_t i = 0; i < size;) {
+        while (i < size && bytes[i] == 0) i++;
+        if (i == size) break;
+        const size_t begin = i;
+        size_t end = i;
+        while (i < size && i - end < SEGMENT_GAP) {
+          if (bytes[i] != 0) end = i + 1;
+          i++;
+        }
+        segments.push_back(0); // Active segment of memory zero
+        segments.push_back(0x41); // i32.const
+        write_sleb(segments, (int32_t)begin);
+        segments.push_back(0x0B);
+        write_uleb(segments, end - begin);
+        write_bytes(segments, bytes + begin, end - begin);
+        segment_count++;
+      }
+
+      Buffer& section = replacements[SECTION_DATA];
+      write_uleb(section, segment_count);
+      write_bytes(section, segments.data(), segments.size());
+      if (find_section(SECTION_DATA_COUNT)) write_uleb(replacements[SECTION_DATA_COUNT], segment_count);
+      return rebuild(replacements);
+    }
+  }
+}
@@ -0,0 +1,75 @@
+#ifndef GODOT_WASM_PREINITIALIZER_H
+#define GODOT_WASM_PREINITIALIZER_H
+
+/*
+Wasm module pre-initialization
+A module is instrumented to export its internal state, instantiated, and initialized once e.g. at export time
+Initialized memory and mutable globals are then baked into data segments and global initializers of a new module
+Similar to Wizer; modules with start functions, imported memory, mutable reference or vector globals, or multiple, shared, or 64-bit memories are unsupported
+Table state is not captured; tables are rebuilt from the original element segments
+*/
+
+#include <map>
+#include <vector>
+#include <wasm.h>
+#include "defs.h"
+
+namespace godot {
+  namespace godot_wasm {
+    class Preinitializer {
+      private:
+        typedef std::vector<uint8_t> Buffer;
+
+        struct Range {
+          size_t begin;
+          size_t end;
+        };
+
+        struct Section {
+          uint8_t id;
+          Range content;
+        };
+
+        struct GlobalEntry {
+          Range type; // Value type and mutability
+          Range init; // Initializer expression
+          int64_t tracked; // Index of baked global; -1 if original initializer is retained
+        };
+
+        struct ExportEntry {
+          Range bytes;
+          String name;
+          uint8_t kind;
+        };
+
+        PackedByteArray bytecode;
+        std::vector<Section> sections;
+        std::vector<GlobalEntry> global_entries;
+        std::vector<ExportEntry> exports;
+        uint32_t imported_globals = 0;
+        bool has_memory = false;
+        bool memory_exported = false;
+        uint8_t memory_flags = 0;
+        uint64_t memory_min = 0;
+        uint64_t memory_max = 0;
+
+        const Section* find_section(uint8_t id) const;
+        PackedByteArray rebuild(const std::map<uint8_t, Buffer>& replacements) const;
+
+      public:
+        struct Global {
+          uint32_t index; // Index in global index space i.e. following imported globals
+          wasm_valkind_t kind;
+        };
+
+        std::vector<Global> globals; // Mutable numeric globals defined by module
+
+        godot_error parse(const PackedByteArray& bytecode_new);
+        PackedByteArray instrument() const;
+        PackedByteArray bake(const std::vector<wasm_val_t>& values, const PackedByteArray& memory) const;
+        static String global_name(uint32_t index);
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef GODOT_WASM_RUNTIME_H
+#define GODOT_WASM_RUNTIME_H
+
+/*
+Runtime specific API
+Wasmer and Wasmtime extend the Wasm C API with e.g. engine configuration
+*/
+
+#include <wasm.h>
+#ifdef RUNTIME_WASMTIME
+  #include <wasmtime.h>
+#elif defined(RUNTIME_WASMER)
+  #include <wasmer.h>
+#endif
+#include "defs.h"
+#include "settings.h"
+
+#ifdef RUNTIME_WASMTIME
+  #define RUNTIME_VERSION "wasmtime-" WASMTIME_VERSION
+#elif defined(RUNTIME_WASMER)
+  #define RUNTIME_VERSION "wasmer-" WASMER_VERSION
+#else
+  #define RUNTIME_VERSION "unknown"
+#endif
+
+namespace godot {
+  namespace godot_wasm {
+    #ifdef RUNTIME_WASMER
+      // Uniform cost per operator; budgets are expressed in executed operators
+      inline uint64_t metering_cost(wasmer_parser_operator_t op) {
+        return 1;
+      }
+    #endif
+
+    // Metering instruments compiled code so that instances may be given an execution budget
+    // Scoped to Wasmer: Wasmtime fuel and epoch deadlines are set via wasmtime_context_t, which Wasm C API stores do not expose
+    // Enabling either on the engine would trap every wasm_store_t call immediately as its fuel and deadline default to zero
+    inline bool metering_available() {
+      #ifdef RUNTIME_WASMER
+        return settings::metering();
+      #else
+        return false;
+      #endif
+    }
+
+    // Engine configuration from project settings; ownership passes to wasm_engine_new_with_config
+    inline wasm_config_t* create_config() {
+      wasm_config_t* config = wasm_config_new();
+      #ifdef RUNTIME_WASMTIME
+        switch (settings::compiler()) {
+          case settings::COMPILER_OPTIMIZING: wasmtime_config_strategy_set(config, WASMTIME_STRATEGY_CRANELIFT); break;
+          case settings::COMPILER_BASELINE: wasmtime_config_strategy_set(config, WASMTIME_STRATEGY_WINCH); break;
+          default: break;
+        }
+        switch (settings::optimization_level()) {
+          case settings::OPTIMIZATION_NONE: wasmtime_config_cranelift_opt_level_set(config, WASMTIME_OPT_LEVEL_NONE); break;
+          case settings::OPTIMIZATION_SPEED_AND_SIZE: wasmtime_config_cranelift_opt_level_set(config, WASMTIME_OPT_LEVEL_SPEED_AND_SIZE); break;
+          default: wasmtime_config_cranelift_opt_level_set(config, WASMTIME_OPT_LEVEL_SPEED); break;
+        }
+        wasmtime_config_parallel_compilation_set(config, settings::parallel_compilation());
+        if (settings::compilation_cache()) {
+          wasmtime_error_t* error = wasmtime_config_cache_config_load(config, NULL); // Default cache location
+          if (error) {
+            PRINT_ERROR("Failed to enable compilation cache");
+            wasmtime_error_delete(error);
+          }
+        }
+      #elif defined(RUNTIME_WASMER)
+        // Wasmer exposes compiler choice only; remaining settings are Wasmtime specific
+        switch (settings::compiler()) {
+          case settings::COMPILER_OPTIMIZING:
+            if (wasmer_is_compiler_available(LLVM)) wasm_config_set_compiler(config, LLVM);
+            else wasm_config_set_compiler(config, CRANELIFT);
+            break;
+          case settings::COMPILER_BASELINE:
+            if (wasmer_is_compiler_available(SINGLEPASS)) wasm_config_set_compiler(config, SINGLEPASS);
+            else PRINT_ERROR("Baseline compiler unavailable");
+            break;
+          default: break;
+        }
+        if (settings::metering()) {
+          wasmer_metering_t* metering = wasmer_metering_new(UINT64_MAX, metering_cost);
+          wasm_config_push_middleware(config, wasmer_metering_as_middleware(metering));
+        }
+      #endif
+      return config;
+    }
+
+    // Resets remaining execution budget of a metered instance; zero budget is unbounded
+    inline void set_budget(const wasm_instance_t* instance, uint64_t budget) {
+      #ifdef RUNTIME_WASMER
+        wasmer_metering_set_remaining_points(instance, budget ? budget : UINT64_MAX);
+      #endif
+    }
+
+    // Whether a metered instance trapped due to its execution budget being exhausted
+    inline bool budget_exhausted(const wasm_instance_t* instance) {
+      #ifdef RUNTIME_WASMER
+        return wasmer_metering_points_are_exhausted(instance);
+      #else
+        return false;
+      #endif
+    }
+
+    // Identifies runtime and engine configuration e.g. for serialized module compatibility
+    inline String engine_id() {
+      return String(RUNTIME_VERSION) + "/" + String::num_int64(settings::compiler()) + "/" + String::num_int64(settings::optimization_level()) + (metering_available() ? "/metered" : "");
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef GODOT_WASM_SETTINGS_H
+#define GODOT_WASM_SETTINGS_H
+
+/*
+Project settings
+Settings (default, hint) are registered once on initialization; accessors return the values read then
+*/
+
+#include "defs.h"
+
+namespace godot {
+  namespace godot_wasm {
+    namespace settings {
+      enum Compiler { COMPILER_DEFAULT, COMPILER_OPTIMIZING, COMPILER_BASELINE };
+      enum OptimizationLevel { OPTIMIZATION_NONE, OPTIMIZATION_SPEED, OPTIMIZATION_SPEED_AND_SIZE };
+
+      inline Variant define(const String& name, const Variant& value, PropertyHint hint = PROPERTY_HINT_NONE, const String& hint_string = "") {
+        ProjectSettings* project_settings = ProjectSettings::get_singleton();
+        if (!project_settings->has_setting(name)) project_settings->set_setting(name, value);
+        project_settings->set_initial_value(name, value);
+        Dictionary info;
+        info["name"] = name;
+        info["type"] = value.get_type();
+        info["hint"] = hint;
+        info["hint_string"] = hint_string;
+        project_settings->add_property_info(info);
+        return project_settings->get_setting(name, value);
+      }
+
+      // Values read once on registration; accessors are safe to call from worker threads e.g. during asynchronous compilation
+      struct Values {
+        Compiler compiler;
+        OptimizationLevel optimization_level;
+        bool parallel_compilation;
+        bool compilation_cache;
+        bool metering;
+        bool module_cache;
+        String module_cache_path;
+      };
+
+      inline Values& values() {
+        static Values values = { COMPILER_DEFAULT, OPTIMIZATION_SPEED, true, false, false, false, "user://wasm_cache" };
+        return values;
+      }
+
+      inline Compiler compiler() { return values().compiler; }
+      inline OptimizationLevel optimization_level() { return values().optimization_level; }
+      inline bool parallel_compilation() { return values().parallel_compilation; }
+      inline bool compilation_cache() { return values().compilation_cache; }
+      inline bool metering() { return values().metering; }
+      inline bool module_cache() { return values().module_cache; }
+      inline String module_cache_path() { return values().module_cache_path; }
+
+      // Called once on the main thread on extension initialization
+      inline void register_settings() {
+        Values& v = values();
+        v.compiler = (Compiler)(int64_t)define("godot_wasm/engine/compiler", COMPILER_DEFAULT, PROPERTY_HINT_ENUM, "Default,Optimizing,Baseline");
+        v.optimization_level = (OptimizationLevel)(int64_t)define("godot_wasm/engine/optimization_level", OPTIMIZATION_SPEED, PROPERTY_HINT_ENUM, "None,Speed,Speed and Size");
+        v.parallel_compilation = define("godot_wasm/engine/parallel_compilation", true);
+        v.compilation_cache = define("godot_wasm/engine/compilation_cache", false);
+        #ifdef RUNTIME_WASMER // Execution budgets are scoped to Wasmer; see metering_available
+          v.metering = define("godot_wasm/engine/metering", false);
+        #endif
+        v.module_cache = define("godot_wasm/module_cache/enabled", false);
+        v.module_cache_path = define("godot_wasm/module_cache/path", "user://wasm_cache", PROPERTY_HINT_DIR);
+      }
+    }
+  }
+}
+
+#endif
@@ -2,39 +2,65 @@
 #define GODOT_WASM_STORE_H
 
 /*
-Singleton Wasm C API store
-The same store is used between all compiled Wasm modules
+Singleton Wasm C API engine and per-instance stores
+The same engine is used between all compiled Wasm modules and is thread safe
+Stores are not thread safe; each instance owns a store so that instances may run concurrently on separate threads
+Engine is configured from project settings on first use
 */
 
+#include <atomic>
+#include <memory>
 #include <wasm.h>
+#include "runtime.h"
 
-#define STORE ::godot_wasm::Store::instance().store
-
-namespace godot_wasm {
-  struct Store {
-    private:
-      Store() {
-        engine = wasm_engine_new();
-        store = wasm_store_new(engine);
-      }
-
-      ~Store() {
-        wasm_store_delete(store);
-        wasm_engine_delete(engine);
-      }
-
-    public:
-      wasm_engine_t* engine;
-      wasm_store_t* store;
-
-      static Store& instance() { // Public accessor
-        static Store s;
-        return s;
-      }
-
-      Store(const Store &) = delete; // Prevent copy constructor
-      Store & operator = (const Store &) = delete; // Prevent assignment
-  };
+#define ENGINE ::godot::godot_wasm::Store::instance().engine
+
+namespace godot {
+  namespace godot_wasm {
+    typedef std::shared_ptr<wasm_store_t> store_ptr; // Shared between an instance and the externs it creates or imports
+    typedef std::shared_ptr<std::atomic<uint64_t>> worker_ptr; // Thread running a resumable call in a store; shared alongside store
+
+    #define WORKER_NONE 0 // No resumable call in progress
+    #define WORKER_PENDING UINT64_MAX // Call started but not yet running on its worker thread
+
+    inline worker_ptr create_worker() {
+      return std::make_shared<std::atomic<uint64_t>>(WORKER_NONE);
+    }
+
+    // Store is in use by a call on another thread; host functions called by the guest run on the worker and may access it
+    inline bool worker_busy(const worker_ptr& worker) {
+      const uint64_t id = worker ? worker->load() : WORKER_NONE;
+      return id != WORKER_NONE && id != (uint64_t)THREAD_ID;
+    }
+
+    struct Store {
+      private:
+        Store() {
+          engine = wasm_engine_new_with_config(create_config());
+          metered = metering_available();
+        }
+
+        ~Store() {
+          wasm_engine_delete(engine);
+        }
+
+      public:
+        wasm_engine_t* engine;
+        bool metered; // Compiled code is instrumented and instances accept execution budgets
+
+        static Store& instance() { // Public accessor
+          static Store s;
+          return s;
+        }
+
+        static store_ptr create() { // New store using the shared engine
+          return store_ptr(wasm_store_new(instance().engine), wasm_store_delete);
+        }
+
+        Store(const Store &) = delete; // Prevent copy constructor
+        Store & operator = (const Store &) = delete; // Prevent assignment
+    };
+  }
 }
 
 #endif
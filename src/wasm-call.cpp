@@ -0,0 +1,157 @@
+#include <chrono>
+#include "wasm-call.h"
+#include "wasm.h"
+
+namespace godot {
+  thread_local WasmCall* WasmCall::current = NULL;
+
+  void WasmCall::REGISTRATION_METHOD() {
+    #ifdef GDNATIVE
+      register_method("get_name", &WasmCall::get_name);
+      register_method("resume", &WasmCall::resume);
+      register_method("is_done", &WasmCall::is_done);
+      register_method("get_result", &WasmCall::get_result);
+    #else
+      ClassDB::bind_method(D_METHOD("get_name"), &WasmCall::get_name);
+      ClassDB::bind_method(D_METHOD("resume", "time_slice"), &WasmCall::resume);
+      ClassDB::bind_method(D_METHOD("is_done"), &WasmCall::is_done);
+      ClassDB::bind_method(D_METHOD("get_result"), &WasmCall::get_result);
+      ADD_SIGNAL(MethodInfo("completed", PropertyInfo(Variant::NIL, "result", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
+    #endif
+  }
+
+  WasmCall::WasmCall() {
+    done = false;
+    finished = false;
+    task = -1;
+    request = NULL;
+    requested = false;
+  }
+
+  WasmCall::~WasmCall() {}
+
+  void WasmCall::_init() {}
+
+  void WasmCall::start(Wasm* wasm_new, const String& name_new, const Array& args_new) {
+    wasm = Ref<Wasm>(wasm_new);
+    name = name_new;
+    args = args_new;
+    // Callable holds a reference so the call outlives its handle
+    const Callable callable = callable_mp_static(&WasmCall::call_worker).bind(Ref<WasmCall>(this));
+    task = WorkerThreadPool::get_singleton()->add_task(callable, false, "Call Wasm function " + name);
+  }
+
+  void WasmCall::call_worker(Ref<WasmCall> call) {
+    current = call.ptr(); // Imports called by the guest are handed off to main thread
+    const Variant value = call->wasm->call_resumable(call->name, call->args);
+    current = NULL;
+    {
+      std::lock_guard<std::mutex> lock(call->mutex);
+      call->result = value;
+      call->done = true;
+    }
+    call->condition.notify_all();
+    callable_mp_static(&WasmCall::call_finish).call_deferred(call);
+  }
+
+  void WasmCall::call_service(Ref<WasmCall> call) {
+    // Serves import on main thread if not already served by resume
+    call->serve();
+  }
+
+  void WasmCall::call_finish(Ref<WasmCall> call) {
+    // Called on main thread once worker has completed
+    call->finish();
+    call->emit_signal("completed", call->result);
+  }
+
+  void WasmCall::call_main(const std::function<void()>& func) {
+    // Called on worker thread; blocks guest until main thread has run the import
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      request = &func;
+      requested = true;
+    }
+    condition.notify_all();
+    callable_mp_static(&WasmCall::call_service).call_deferred(Ref<WasmCall>(this));
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return request == NULL; });
+  }
+
+  void WasmCall::serve() {
+    // Main thread only; store is handed to main thread while the guest waits on its worker
+    const std::function<void()>* func;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!requested) return;
+      requested = false;
+      func = request;
+    }
+    const uint64_t owner = wasm->worker->exchange(THREAD_ID);
+    (*func)();
+    wasm->worker->store(owner);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      request = NULL;
+    }
+    condition.notify_all();
+  }
+
+  void WasmCall::finish() {
+    // Main thread only; releases instance once worker has completed
+    if (finished) return;
+    finished = true;
+    release_task();
+    *wasm->worker = WORKER_NONE;
+    const Ref<WasmMemory> memory = wasm->get_memory();
+    if (memory.is_valid()) memory->poll_growth(); // Notify of growth by guest
+    wasm->release_output(); // Output deferred while running on worker thread
+    wasm->finish_exit(); // Guest exited on worker thread
+  }
+
+  void WasmCall::release_task() {
+    // Tasks must be waited on from the main thread to be freed
+    if (task < 0) return;
+    WorkerThreadPool::get_singleton()->wait_for_task_completion(task);
+    task = -1;
+  }
+
+  WasmCall* WasmCall::get_current() {
+    return current;
+  }
+
+  String WasmCall::get_name() const {
+    return name;
+  }
+
+  bool WasmCall::resume(int64_t time_slice) {
+    FAIL_IF(time_slice < 0, "Invalid time slice", false);
+    const bool main = IS_MAIN_THREAD;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_slice);
+    while (true) {
+      {
+        // Block for at most the time slice; guest continues on its worker thread otherwise
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!condition.wait_until(lock, deadline, [this, main] { return done || (main && requested); })) return false;
+        if (done) break;
+      }
+      serve(); // Run import called by the guest meanwhile
+    }
+    if (main) finish();
+    return true;
+  }
+
+  bool WasmCall::is_done() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!done) return false;
+    }
+    if (IS_MAIN_THREAD) finish(); // Release instance as soon as completion is observed
+    return true;
+  }
+
+  Variant WasmCall::get_result() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return result;
+  }
+}
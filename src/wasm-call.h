@@ -0,0 +1,51 @@
+#ifndef WASM_CALL_H
+#define WASM_CALL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include "defs.h"
+
+namespace godot {
+  class Wasm; // Forward declare to avoid circular dependency
+
+  class WasmCall : public RefCounted {
+    GDCLASS(WasmCall, RefCounted);
+    friend class Wasm; // Instances start calls
+
+    private:
+      Ref<Wasm> wasm;
+      String name;
+      Array args;
+      Variant result; // Guarded by mutex until done
+      bool done;
+      bool finished; // Instance released on main thread; main thread only
+      int64_t task; // Worker task; -1 once completed and waited on
+      const std::function<void()>* request; // Import call handed off to main thread; guarded by mutex
+      bool requested; // Request pending and not yet taken by main thread; guarded by mutex
+      mutable std::mutex mutex;
+      std::condition_variable condition;
+      static thread_local WasmCall* current; // Call running on this worker thread; NULL if none
+      void start(Wasm* wasm_new, const String& name_new, const Array& args_new);
+      void release_task();
+      void serve();
+      void finish();
+      static void call_worker(Ref<WasmCall> call);
+      static void call_service(Ref<WasmCall> call);
+      static void call_finish(Ref<WasmCall> call);
+
+    public:
+      static void REGISTRATION_METHOD();
+      WasmCall();
+      ~WasmCall();
+      void _init();
+      String get_name() const;
+      bool resume(int64_t time_slice);
+      bool is_done();
+      Variant get_result() const;
+      void call_main(const std::function<void()>& func);
+      static WasmCall* get_current();
+  };
+}
+
+#endif
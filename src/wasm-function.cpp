@@ -0,0 +1,47 @@
+#include "wasm-function.h"
+#include "wasm.h"
+
+namespace godot {
+  void WasmFunction::REGISTRATION_METHOD() {
+    #ifdef GDNATIVE
+      register_method("get_name", &WasmFunction::get_name);
+      register_method("invokev", &WasmFunction::invokev);
+    #else
+      ClassDB::bind_method(D_METHOD("get_name"), &WasmFunction::get_name);
+      ClassDB::bind_method(D_METHOD("invokev", "args"), &WasmFunction::invokev);
+      ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "invoke", &WasmFunction::invoke, MethodInfo("invoke"));
+    #endif
+  }
+
+  WasmFunction::WasmFunction() {
+    context = NULL;
+    generation = 0;
+  }
+
+  WasmFunction::~WasmFunction() {}
+
+  void WasmFunction::_init() {}
+
+  void WasmFunction::bind(Wasm* wasm_new, const String& name_new, const godot_wasm::ContextFuncExport* context_new, uint64_t generation_new) {
+    wasm = Ref<Wasm>(wasm_new);
+    name = name_new;
+    context = context_new;
+    generation = generation_new;
+  }
+
+  String WasmFunction::get_name() const {
+    return name;
+  }
+
+  Variant WasmFunction::invoke(VARARG_SIGNATURE) {
+    FAIL_IF(wasm.is_null() || context == NULL, "Unbound function", NULL_VARIANT);
+    FAIL_IF(wasm->get_generation() != generation, "Stale function " + name, NULL_VARIANT);
+    return wasm->invoke(*context, name, p_args, p_arg_count);
+  }
+
+  Variant WasmFunction::invokev(const Array& args) {
+    FAIL_IF(wasm.is_null() || context == NULL, "Unbound function", NULL_VARIANT);
+    FAIL_IF(wasm->get_generation() != generation, "Stale function " + name, NULL_VARIANT);
+    return wasm->invoke(*context, name, args);
+  }
+}
@@ -0,0 +1,34 @@
+#ifndef WASM_FUNCTION_H
+#define WASM_FUNCTION_H
+
+#include "defs.h"
+
+namespace godot {
+  class Wasm; // Forward declare to avoid circular dependency
+
+  namespace godot_wasm {
+    struct ContextFuncExport;
+  }
+
+  class WasmFunction : public RefCounted {
+    GDCLASS(WasmFunction, RefCounted);
+
+    private:
+      Ref<Wasm> wasm;
+      String name;
+      const godot_wasm::ContextFuncExport* context; // Non-owning; valid while generation matches
+      uint64_t generation; // Instance generation at time of resolution
+
+    public:
+      static void REGISTRATION_METHOD();
+      WasmFunction();
+      ~WasmFunction();
+      void _init();
+      void bind(Wasm* wasm_new, const String& name_new, const godot_wasm::ContextFuncExport* context_new, uint64_t generation_new);
+      String get_name() const;
+      Variant invoke(VARARG_SIGNATURE);
+      Variant invokev(const Array& args);
+  };
+}
+
+#endif
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <wasm.h>
 #include "wasm-memory.h"
 #include "store.h"
@@ -17,18 +19,103 @@
   #define INTERFACE_INIT
 #endif
 
+#define IMAGE_SIZE_MAX (1 << 24) // Maximum image width or height
+#define PAGES_MAX 65536 // Pages addressable by 32-bit memory
+#define COMPARE_ERROR -2 // Result of failed compare; distinct from ordering results -1, 0, and 1
+
+namespace {
+  // Bytes per pixel of uncompressed image formats; zero if unsupported
+  int64_t pixel_size(int64_t format) {
+    switch (format) {
+      case godot::Image::FORMAT_L8: case godot::Image::FORMAT_R8: return 1;
+      case godot::Image::FORMAT_LA8: case godot::Image::FORMAT_RG8: case godot::Image::FORMAT_RGBA4444: case godot::Image::FORMAT_RGB565: case godot::Image::FORMAT_RH: return 2;
+      case godot::Image::FORMAT_RGB8: return 3;
+      case godot::Image::FORMAT_RGBA8: case godot::Image::FORMAT_RF: case godot::Image::FORMAT_RGH: return 4;
+      case godot::Image::FORMAT_RGBH: return 6;
+      case godot::Image::FORMAT_RGF: case godot::Image::FORMAT_RGBAH: return 8;
+      case godot::Image::FORMAT_RGBF: return 12;
+      case godot::Image::FORMAT_RGBAF: return 16;
+      default: return 0;
+    }
+  }
+}
+
 namespace godot {
   void WasmMemory::REGISTRATION_METHOD() {
     #ifdef GDNATIVE
       register_method("inspect", &WasmMemory::inspect);
       register_method("grow", &WasmMemory::grow);
+      register_method("reserve", &WasmMemory::reserve);
+      register_property<WasmMemory, double>("growth_factor", &WasmMemory::set_growth_factor, &WasmMemory::get_growth_factor, 1.0);
+      register_property<WasmMemory, int64_t>("maximum_pages", &WasmMemory::set_maximum_pages, &WasmMemory::get_maximum_pages, 0);
+      register_property<WasmMemory, double>("warning_threshold", &WasmMemory::set_warning_threshold, &WasmMemory::get_warning_threshold, 0.9);
       register_method("seek", &WasmMemory::seek);
       register_method("get_position", &WasmMemory::get_position);
+      register_method("read_bytes", &WasmMemory::read_bytes);
+      register_method("read_int32s", &WasmMemory::read_int32s);
+      register_method("read_int64s", &WasmMemory::read_int64s);
+      register_method("read_floats", &WasmMemory::read_floats);
+      register_method("read_doubles", &WasmMemory::read_doubles);
+      register_method("read_vector2s", &WasmMemory::read_vector2s);
+      register_method("read_vector3s", &WasmMemory::read_vector3s);
+      register_method("read_colors", &WasmMemory::read_colors);
+      register_method("write_bytes", &WasmMemory::write_bytes);
+      register_method("write_int32s", &WasmMemory::write_int32s);
+      register_method("write_int64s", &WasmMemory::write_int64s);
+      register_method("write_floats", &WasmMemory::write_floats);
+      register_method("write_doubles", &WasmMemory::write_doubles);
+      register_method("write_vector2s", &WasmMemory::write_vector2s);
+      register_method("write_vector3s", &WasmMemory::write_vector3s);
+      register_method("write_colors", &WasmMemory::write_colors);
+      register_method("to_image", &WasmMemory::to_image);
+      register_method("update_texture", &WasmMemory::update_texture);
+      register_method("to_mesh_arrays", &WasmMemory::to_mesh_arrays);
+      register_method("fill", &WasmMemory::fill);
+      register_method("copy", &WasmMemory::copy);
+      register_method("compare", &WasmMemory::compare);
+      register_method("find", &WasmMemory::find);
+      register_method("restore", &WasmMemory::restore);
     #else
       ClassDB::bind_method(D_METHOD("inspect"), &WasmMemory::inspect);
       ClassDB::bind_method(D_METHOD("grow", "pages"), &WasmMemory::grow);
+      ClassDB::bind_method(D_METHOD("reserve", "pages"), &WasmMemory::reserve);
+      ClassDB::bind_method(D_METHOD("set_growth_factor", "factor"), &WasmMemory::set_growth_factor);
+      ClassDB::bind_method(D_METHOD("get_growth_factor"), &WasmMemory::get_growth_factor);
+      ClassDB::bind_method(D_METHOD("set_maximum_pages", "maximum"), &WasmMemory::set_maximum_pages);
+      ClassDB::bind_method(D_METHOD("get_maximum_pages"), &WasmMemory::get_maximum_pages);
+      ClassDB::bind_method(D_METHOD("set_warning_threshold", "threshold"), &WasmMemory::set_warning_threshold);
+      ClassDB::bind_method(D_METHOD("get_warning_threshold"), &WasmMemory::get_warning_threshold);
       ClassDB::bind_method(D_METHOD("seek", "p_pos"), &WasmMemory::seek);
       ClassDB::bind_method(D_METHOD("get_position"), &WasmMemory::get_position);
+      ClassDB::bind_method(D_METHOD("read_bytes", "offset", "count"), &WasmMemory::read_bytes);
+      ClassDB::bind_method(D_METHOD("read_int32s", "offset", "count"), &WasmMemory::read_int32s);
+      ClassDB::bind_method(D_METHOD("read_int64s", "offset", "count"), &WasmMemory::read_int64s);
+      ClassDB::bind_method(D_METHOD("read_floats", "offset", "count"), &WasmMemory::read_floats);
+      ClassDB::bind_method(D_METHOD("read_doubles", "offset", "count"), &WasmMemory::read_doubles);
+      ClassDB::bind_method(D_METHOD("read_vector2s", "offset", "count"), &WasmMemory::read_vector2s);
+      ClassDB::bind_method(D_METHOD("read_vector3s", "offset", "count"), &WasmMemory::read_vector3s);
+      ClassDB::bind_method(D_METHOD("read_colors", "offset", "count"), &WasmMemory::read_colors);
+      ClassDB::bind_method(D_METHOD("write_bytes", "offset", "values"), &WasmMemory::write_bytes);
+      ClassDB::bind_method(D_METHOD("write_int32s", "offset", "values"), &WasmMemory::write_int32s);
+      ClassDB::bind_method(D_METHOD("write_int64s", "offset", "values"), &WasmMemory::write_int64s);
+      ClassDB::bind_method(D_METHOD("write_floats", "offset", "values"), &WasmMemory::write_floats);
+      ClassDB::bind_method(D_METHOD("write_doubles", "offset", "values"), &WasmMemory::write_doubles);
+      ClassDB::bind_method(D_METHOD("write_vector2s", "offset", "values"), &WasmMemory::write_vector2s);
+      ClassDB::bind_method(D_METHOD("write_vector3s", "offset", "values"), &WasmMemory::write_vector3s);
+      ClassDB::bind_method(D_METHOD("write_colors", "offset", "values"), &WasmMemory::write_colors);
+      ClassDB::bind_method(D_METHOD("to_image", "offset", "width", "height", "format"), &WasmMemory::to_image);
+      ClassDB::bind_method(D_METHOD("update_texture", "texture", "offset"), &WasmMemory::update_texture);
+      ClassDB::bind_method(D_METHOD("to_mesh_arrays", "layout"), &WasmMemory::to_mesh_arrays);
+      ClassDB::bind_method(D_METHOD("fill", "offset", "value", "length"), &WasmMemory::fill);
+      ClassDB::bind_method(D_METHOD("copy", "destination", "source", "length"), &WasmMemory::copy);
+      ClassDB::bind_method(D_METHOD("compare", "a", "b", "length"), &WasmMemory::compare);
+      ClassDB::bind_method(D_METHOD("find", "pattern", "offset"), &WasmMemory::find, DEFVAL(0));
+      ClassDB::bind_method(D_METHOD("restore", "data"), &WasmMemory::restore);
+      ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "growth_factor", PROPERTY_HINT_RANGE, "1,4,0.1"), "set_growth_factor", "get_growth_factor");
+      ADD_PROPERTY(PropertyInfo(Variant::INT, "maximum_pages", PROPERTY_HINT_RANGE, "0,65536"), "set_maximum_pages", "get_maximum_pages");
+      ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "warning_threshold", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_warning_threshold", "get_warning_threshold");
+      ADD_SIGNAL(MethodInfo("grown", PropertyInfo(Variant::INT, "previous_pages"), PropertyInfo(Variant::INT, "pages")));
+      ADD_SIGNAL(MethodInfo("limit_approaching", PropertyInfo(Variant::INT, "pages"), PropertyInfo(Variant::INT, "maximum_pages")));
     #endif
   }
 
@@ -36,43 +123,148 @@ namespace godot {
     INTERFACE_DEFINE;
     memory = NULL;
     pointer = 0;
+    pages = 0;
+    growth_factor = 1.0;
+    maximum_pages = 0;
+    warning_threshold = 0.9;
+    warned = false;
   }
 
   WasmMemory::~WasmMemory() {
-    set_memory(NULL);
+    set_memory(NULL, NULL, NULL);
   }
 
   void WasmMemory::_init() {
     INTERFACE_INIT;
   }
 
-  void WasmMemory::set_memory(const wasm_memory_t* memory_new) {
-    if (memory != NULL) wasm_memory_delete(memory);
+  void WasmMemory::set_memory(const wasm_memory_t* memory_new, const godot_wasm::store_ptr& store_new, const godot_wasm::worker_ptr& worker_new) {
+    if (memory != NULL) wasm_memory_delete(memory); // Delete prior to releasing store
     memory = (wasm_memory_t*)memory_new;
+    store = store_new;
+    worker = worker_new;
+    pages = memory ? wasm_memory_size(memory) : 0;
+    warned = false;
   }
 
   wasm_memory_t* WasmMemory::get_memory() const {
     return memory;
   }
 
+  godot_wasm::store_ptr WasmMemory::get_store() const {
+    return store;
+  }
+
+  godot_wasm::worker_ptr WasmMemory::get_worker() const {
+    return worker;
+  }
+
+  bool WasmMemory::is_busy() const {
+    return godot_wasm::worker_busy(worker);
+  }
+
+  wasm_limits_t WasmMemory::get_limits() const {
+    // Memory type is a copy owned by the caller
+    wasm_memorytype_t* type = wasm_memory_type(memory);
+    const wasm_limits_t limits = *wasm_memorytype_limits(type);
+    wasm_memorytype_delete(type);
+    return limits;
+  }
+
   Dictionary WasmMemory::inspect() const {
     if (memory == NULL) return Dictionary();
-    auto limits = wasm_memorytype_limits(wasm_memory_type(memory));
+    FAIL_IF(is_busy(), "Call in progress", Dictionary());
+    const wasm_limits_t limits = get_limits();
     Dictionary dict;
-    dict["min"] = limits->min * PAGE_SIZE;
-    dict["max"] = limits->max * PAGE_SIZE;
+    dict["min"] = limits.min * PAGE_SIZE;
+    dict["max"] = limits.max * PAGE_SIZE;
     dict["current"] = wasm_memory_size(memory) * PAGE_SIZE;
     return dict;
   }
 
-  godot_error WasmMemory::grow(uint32_t pages) {
+  uint32_t WasmMemory::get_limit() const {
+    const uint32_t declared = std::min<uint32_t>(get_limits().max, PAGES_MAX);
+    return maximum_pages ? std::min(maximum_pages, declared) : declared;
+  }
+
+  godot_error WasmMemory::grow_exact(uint32_t delta) {
+    FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    const uint32_t limit = get_limit();
+    const uint32_t current = wasm_memory_size(memory);
+    FAIL_IF(current > limit || delta > limit - current, "Memory limit exceeded", FAILED);
+    if (!wasm_memory_grow(memory, delta)) return FAILED;
+    poll_growth();
+    return OK;
+  }
+
+  godot_error WasmMemory::grow(uint32_t delta) {
     if (!memory) { // Create new memory
-      const wasm_limits_t limits = { pages, wasm_limits_max_default };
-      memory = wasm_memory_new(STORE, wasm_memorytype_new(&limits));
-      return memory ? OK : FAILED;
+      FAIL_IF(maximum_pages && delta > maximum_pages, "Memory limit exceeded", FAILED);
+      // Maximum is part of the memory type so also bounds growth by importing modules
+      const wasm_limits_t limits = { delta, maximum_pages ? maximum_pages : wasm_limits_max_default };
+      store = godot_wasm::Store::create(); // Adopted by instances importing this memory
+      worker = godot_wasm::create_worker();
+      wasm_memorytype_t* type = wasm_memorytype_new(&limits);
+      memory = wasm_memory_new(store.get(), type);
+      wasm_memorytype_delete(type);
+      if (!memory) return FAILED;
+      poll_growth();
+      return OK;
     }
-    FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
-    return wasm_memory_grow(memory, pages) ? OK : FAILED;
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    // Geometric growth amortizes repeated small requests; capped rather than failing if the request itself fits
+    const uint32_t current = wasm_memory_size(memory);
+    const uint32_t available = get_limit() - std::min(current, get_limit());
+    const uint32_t geometric = std::min<double>(current * (growth_factor - 1.0), available);
+    return grow_exact(std::max(delta, geometric));
+  }
+
+  godot_error WasmMemory::reserve(uint32_t total) {
+    if (!memory) return grow(total);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    const uint32_t current = wasm_memory_size(memory);
+    return total > current ? grow_exact(total - current) : OK;
+  }
+
+  void WasmMemory::poll_growth() {
+    // Growth by host or guest is observed after the fact as guest memory.grow cannot be intercepted
+    if (memory == NULL || is_busy()) return; // Observed once call completes
+    const uint32_t current = wasm_memory_size(memory);
+    if (current == pages) return;
+    const uint32_t previous = pages;
+    pages = current;
+    // Growth may be observed on a worker thread e.g. by a WasmPool instance; signals are emitted on main thread
+    EMIT_SIGNAL_MAIN_THREAD(this, "grown", previous, current);
+    // Emitted once per crossing; re-armed once below threshold e.g. after raising the maximum
+    const uint32_t maximum = get_limit();
+    const bool approaching = current >= warning_threshold * maximum;
+    if (approaching && !warned) EMIT_SIGNAL_MAIN_THREAD(this, "limit_approaching", current, maximum);
+    warned = approaching;
+  }
+
+  void WasmMemory::set_growth_factor(double factor) {
+    growth_factor = std::max(factor, 1.0);
+  }
+
+  double WasmMemory::get_growth_factor() const {
+    return growth_factor;
+  }
+
+  void WasmMemory::set_maximum_pages(int64_t maximum) {
+    maximum_pages = std::clamp<int64_t>(maximum, 0, PAGES_MAX);
+  }
+
+  int64_t WasmMemory::get_maximum_pages() const {
+    return maximum_pages;
+  }
+
+  void WasmMemory::set_warning_threshold(double threshold) {
+    warning_threshold = std::clamp(threshold, 0.0, 1.0);
+  }
+
+  double WasmMemory::get_warning_threshold() const {
+    return warning_threshold;
   }
 
   Ref<WasmMemory> WasmMemory::seek(int p_pos) {
@@ -86,8 +278,232 @@ namespace godot {
     return pointer;
   }
 
+  bool WasmMemory::in_bounds(int64_t offset, int64_t bytes) const {
+    // Single check per bulk operation; ordered to avoid overflow of offset + bytes
+    const uint64_t size = wasm_memory_data_size(memory);
+    return offset >= 0 && bytes >= 0 && (uint64_t)bytes <= size && (uint64_t)offset <= size - bytes;
+  }
+
+  template <typename T> T WasmMemory::read_array(int64_t offset, int64_t count) const {
+    T values;
+    FAIL_IF(memory == NULL, "Invalid memory", values);
+    FAIL_IF(is_busy(), "Call in progress", values);
+    FAIL_IF(count < 0 || (uint64_t)count > wasm_memory_data_size(memory), "Memory access out of bounds", values);
+    const int64_t bytes = count * (int64_t)sizeof(values.ptr()[0]);
+    FAIL_IF(!in_bounds(offset, bytes), "Memory access out of bounds", values);
+    values.resize(count);
+    if (bytes) memcpy(values.ptrw(), wasm_memory_data(memory) + offset, bytes);
+    return values;
+  }
+
+  template <typename T, int N> T WasmMemory::read_reals(int64_t offset, int64_t count) const {
+    // Vector components are stored as 32-bit floats regardless of real_t precision e.g. double precision builds
+    if constexpr (sizeof(real_t) == sizeof(float)) return read_array<T>(offset, count);
+    T values;
+    FAIL_IF(count < 0 || count > INT32_MAX, "Memory access out of bounds", values);
+    const PackedFloat32Array floats = read_floats(offset, count * N);
+    if (floats.size() != count * N) return values;
+    values.resize(count);
+    const float* in = floats.ptr();
+    for (int64_t i = 0; i < count; i++, in += N) {
+      if constexpr (N == 2) values.set(i, Vector2(in[0], in[1]));
+      else values.set(i, Vector3(in[0], in[1], in[2]));
+    }
+    return values;
+  }
+
+  template <typename T> godot_error WasmMemory::write_array(int64_t offset, const T& values) {
+    FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    const int64_t bytes = values.size() * (int64_t)sizeof(values.ptr()[0]);
+    FAIL_IF(!in_bounds(offset, bytes), "Memory access out of bounds", ERR_PARAMETER_RANGE_ERROR);
+    if (bytes) memcpy(wasm_memory_data(memory) + offset, values.ptr(), bytes);
+    return OK;
+  }
+
+  PackedByteArray WasmMemory::read_bytes(int64_t offset, int64_t count) const {
+    return read_array<PackedByteArray>(offset, count);
+  }
+
+  PackedInt32Array WasmMemory::read_int32s(int64_t offset, int64_t count) const {
+    return read_array<PackedInt32Array>(offset, count);
+  }
+
+  PackedInt64Array WasmMemory::read_int64s(int64_t offset, int64_t count) const {
+    return read_array<PackedInt64Array>(offset, count);
+  }
+
+  PackedFloat32Array WasmMemory::read_floats(int64_t offset, int64_t count) const {
+    return read_array<PackedFloat32Array>(offset, count);
+  }
+
+  PackedFloat64Array WasmMemory::read_doubles(int64_t offset, int64_t count) const {
+    return read_array<PackedFloat64Array>(offset, count);
+  }
+
+  PackedVector2Array WasmMemory::read_vector2s(int64_t offset, int64_t count) const {
+    return read_array<PackedVector2Array>(offset, count);
+  }
+
+  PackedVector3Array WasmMemory::read_vector3s(int64_t offset, int64_t count) const {
+    return read_array<PackedVector3Array>(offset, count);
+  }
+
+  PackedColorArray WasmMemory::read_colors(int64_t offset, int64_t count) const {
+    return read_array<PackedColorArray>(offset, count);
+  }
+
+  godot_error WasmMemory::write_bytes(int64_t offset, const PackedByteArray& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_int32s(int64_t offset, const PackedInt32Array& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_int64s(int64_t offset, const PackedInt64Array& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_floats(int64_t offset, const PackedFloat32Array& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_doubles(int64_t offset, const PackedFloat64Array& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_vector2s(int64_t offset, const PackedVector2Array& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_vector3s(int64_t offset, const PackedVector3Array& values) {
+    return write_array(offset, values);
+  }
+
+  godot_error WasmMemory::write_colors(int64_t offset, const PackedColorArray& values) {
+    return write_array(offset, values);
+  }
+
+  Ref<Image> WasmMemory::to_image(int64_t offset, int64_t width, int64_t height, int64_t format) const {
+    FAIL_IF(width <= 0 || height <= 0 || width > IMAGE_SIZE_MAX || height > IMAGE_SIZE_MAX, "Invalid image size", Ref<Image>());
+    const int64_t bytes = pixel_size(format);
+    FAIL_IF(bytes == 0, "Unsupported image format", Ref<Image>());
+    // Image shares the copied buffer so memory is read exactly once
+    const PackedByteArray data = read_bytes(offset, width * height * bytes);
+    FAIL_IF(data.size() != width * height * bytes, "Failed to read image", Ref<Image>());
+    return Image::create_from_data(width, height, false, (Image::Format)format, data);
+  }
+
+  godot_error WasmMemory::update_texture(const Ref<ImageTexture>& texture, int64_t offset) const {
+    FAIL_IF(texture.is_null(), "Invalid texture", ERR_INVALID_PARAMETER);
+    // Texture size and format are unchanged so update avoids reallocating on the GPU
+    const Ref<Image> image = to_image(offset, texture->get_width(), texture->get_height(), texture->get_format());
+    FAIL_IF(image.is_null(), "Failed to update texture", ERR_INVALID_DATA);
+    texture->update(image);
+    return OK;
+  }
+
+  Array WasmMemory::to_mesh_arrays(const Dictionary layout) const {
+    // Layout maps mesh array types to offset and element count pairs; counts are per vertex, or per index for indices
+    // Floats are 32-bit regardless of real_t precision and integers are 32-bit
+    Array arrays;
+    arrays.resize(Mesh::ARRAY_MAX);
+    const Array keys = layout.keys();
+    for (int64_t i = 0; i < keys.size(); i++) {
+      const int64_t type = keys[i];
+      const Array range = layout[keys[i]];
+      FAIL_IF(range.size() != 2, "Invalid mesh layout", Array());
+      const int64_t offset = range[0];
+      const int64_t count = range[1];
+      FAIL_IF(count < 0 || count > INT32_MAX, "Invalid mesh layout", Array());
+      const auto read = [&](const auto& values, int64_t size) { arrays[type] = values; return values.size() == size; };
+      bool valid;
+      switch (type) {
+        // Vertex positions and normals; 3 floats (x, y, z) per vertex
+        case Mesh::ARRAY_VERTEX: case Mesh::ARRAY_NORMAL: valid = read(read_reals<PackedVector3Array, 3>(offset, count), count); break;
+        // Tangents; 4 floats (x, y, z, binormal sign) per vertex
+        // Bone weights; 4 floats per vertex i.e. 8 bone weights are unsupported
+        case Mesh::ARRAY_TANGENT: case Mesh::ARRAY_WEIGHTS: valid = read(read_floats(offset, count * 4), count * 4); break;
+        // Colors; 4 floats (r, g, b, a) per vertex
+        case Mesh::ARRAY_COLOR: valid = read(read_colors(offset, count), count); break;
+        // Texture coordinates; 2 floats (u, v) per vertex
+        case Mesh::ARRAY_TEX_UV: case Mesh::ARRAY_TEX_UV2: valid = read(read_reals<PackedVector2Array, 2>(offset, count), count); break;
+        // Bone indices; 4 integers per vertex
+        case Mesh::ARRAY_BONES: valid = read(read_int32s(offset, count * 4), count * 4); break;
+        // Indices; 1 integer per index
+        case Mesh::ARRAY_INDEX: valid = read(read_int32s(offset, count), count); break;
+        default: FAIL("Unsupported mesh array type", Array());
+      }
+      FAIL_IF(!valid, "Failed to read mesh array", Array());
+    }
+    return arrays;
+  }
+
+  godot_error WasmMemory::fill(int64_t offset, uint8_t value, int64_t length) {
+    FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    FAIL_IF(!in_bounds(offset, length), "Memory access out of bounds", ERR_PARAMETER_RANGE_ERROR);
+    memset(wasm_memory_data(memory) + offset, value, length);
+    return OK;
+  }
+
+  godot_error WasmMemory::copy(int64_t destination, int64_t source, int64_t length) {
+    FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    FAIL_IF(!in_bounds(destination, length) || !in_bounds(source, length), "Memory access out of bounds", ERR_PARAMETER_RANGE_ERROR);
+    memmove(wasm_memory_data(memory) + destination, wasm_memory_data(memory) + source, length); // Ranges may overlap
+    return OK;
+  }
+
+  int64_t WasmMemory::compare(int64_t a, int64_t b, int64_t length) const {
+    FAIL_IF(memory == NULL, "Invalid memory", COMPARE_ERROR);
+    FAIL_IF(is_busy(), "Call in progress", COMPARE_ERROR);
+    FAIL_IF(!in_bounds(a, length) || !in_bounds(b, length), "Memory access out of bounds", COMPARE_ERROR);
+    const int result = memcmp(wasm_memory_data(memory) + a, wasm_memory_data(memory) + b, length);
+    return (result > 0) - (result < 0);
+  }
+
+  int64_t WasmMemory::find(const PackedByteArray& pattern, int64_t offset) const {
+    FAIL_IF(memory == NULL, "Invalid memory", -1);
+    FAIL_IF(is_busy(), "Call in progress", -1);
+    FAIL_IF(pattern.is_empty(), "Invalid pattern", -1);
+    FAIL_IF(!in_bounds(offset, 0), "Memory access out of bounds", -1);
+    // Scan for first byte then confirm remainder; both are vectorized by the C library
+    const byte_t* data = wasm_memory_data(memory);
+    const byte_t* end = data + wasm_memory_data_size(memory);
+    const uint8_t* needle = pattern.ptr();
+    const size_t length = pattern.size();
+    for (const byte_t* it = data + offset; (size_t)(end - it) >= length; it++) {
+      it = (const byte_t*)memchr(it, needle[0], end - it - length + 1);
+      if (it == NULL) break;
+      if (memcmp(it, needle, length) == 0) return it - data;
+    }
+    return -1;
+  }
+
+  godot_error WasmMemory::restore(const PackedByteArray& data) {
+    FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    const size_t size = wasm_memory_data_size(memory);
+    const size_t length = data.size();
+    FAIL_IF(length > size, "Snapshot larger than memory", ERR_PARAMETER_RANGE_ERROR);
+    // Only pages that differ are written so untouched copy-on-write pages remain shared
+    byte_t* destination = wasm_memory_data(memory);
+    const uint8_t* source = data.ptr();
+    for (size_t page = 0; page < length; page += PAGE_SIZE) {
+      const size_t bytes = std::min<size_t>(PAGE_SIZE, length - page);
+      if (memcmp(destination + page, source + page, bytes)) memcpy(destination + page, source + page, bytes);
+    }
+    // Memory cannot shrink; pages grown since capture are cleared instead
+    if (size > length) memset(destination + length, 0, size - length);
+    return OK;
+  }
+
   godot_error WasmMemory::INTERFACE_GET_DATA {
     FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+    FAIL_IF(!in_bounds(pointer, bytes), "Memory access out of bounds", ERR_PARAMETER_RANGE_ERROR);
     byte_t* data = wasm_memory_data(memory) + pointer;
     memcpy(buffer, data, bytes);
     pointer += bytes;
@@ -108,7 +524,9 @@ namespace godot {
 
   godot_error WasmMemory::INTERFACE_PUT_DATA {
     FAIL_IF(memory == NULL, "Invalid memory", ERR_INVALID_DATA);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
     if (bytes <= 0) return OK;
+    FAIL_IF(!in_bounds(pointer, bytes), "Memory access out of bounds", ERR_PARAMETER_RANGE_ERROR);
     byte_t* data = wasm_memory_data(memory) + pointer;
     memcpy(data, buffer, bytes);
     pointer += bytes;
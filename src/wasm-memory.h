@@ -1,7 +1,9 @@
 #ifndef WASM_MEMORY_H
 #define WASM_MEMORY_H
 
+#include <wasm.h>
 #include "defs.h"
+#include "store.h"
 
 #ifdef GODOT_MODULE
   #define SUPER_CLASS StreamPeer
@@ -28,19 +30,68 @@ namespace godot {
     private:
       INTERFACE_DECLARE;
       wasm_memory_t* memory;
+      godot_wasm::store_ptr store; // Store owning memory
+      godot_wasm::worker_ptr worker; // Resumable call using store; accessors fail while it runs on another thread
       uint32_t pointer;
+      uint32_t pages; // Size when growth was last observed
+      double growth_factor;
+      uint32_t maximum_pages; // Zero defers to memory type limits
+      double warning_threshold;
+      bool warned; // Limit approaching signal emitted since last below threshold
+      uint32_t get_limit() const;
+      godot_error grow_exact(uint32_t delta);
+      bool in_bounds(int64_t offset, int64_t bytes) const;
+      template <typename T> T read_array(int64_t offset, int64_t count) const;
+      template <typename T, int N> T read_reals(int64_t offset, int64_t count) const;
+      template <typename T> godot_error write_array(int64_t offset, const T& values);
 
     public:
       static void REGISTRATION_METHOD();
       WasmMemory();
       ~WasmMemory();
       void _init();
-      void set_memory(const wasm_memory_t* memory_new);
+      void set_memory(const wasm_memory_t* memory_new, const godot_wasm::store_ptr& store_new, const godot_wasm::worker_ptr& worker_new);
       wasm_memory_t* get_memory() const;
+      godot_wasm::store_ptr get_store() const;
+      godot_wasm::worker_ptr get_worker() const;
+      bool is_busy() const;
+      wasm_limits_t get_limits() const;
       Dictionary inspect() const;
-      godot_error grow(uint32_t pages);
+      godot_error grow(uint32_t delta);
+      godot_error reserve(uint32_t total);
+      void poll_growth();
+      void set_growth_factor(double factor);
+      double get_growth_factor() const;
+      void set_maximum_pages(int64_t maximum);
+      int64_t get_maximum_pages() const;
+      void set_warning_threshold(double threshold);
+      double get_warning_threshold() const;
       Ref<WasmMemory> seek(int p_pos);
       uint32_t get_position() const;
+      PackedByteArray read_bytes(int64_t offset, int64_t count) const;
+      PackedInt32Array read_int32s(int64_t offset, int64_t count) const;
+      PackedInt64Array read_int64s(int64_t offset, int64_t count) const;
+      PackedFloat32Array read_floats(int64_t offset, int64_t count) const;
+      PackedFloat64Array read_doubles(int64_t offset, int64_t count) const;
+      PackedVector2Array read_vector2s(int64_t offset, int64_t count) const;
+      PackedVector3Array read_vector3s(int64_t offset, int64_t count) const;
+      PackedColorArray read_colors(int64_t offset, int64_t count) const;
+      godot_error write_bytes(int64_t offset, const PackedByteArray& values);
+      godot_error write_int32s(int64_t offset, const PackedInt32Array& values);
+      godot_error write_int64s(int64_t offset, const PackedInt64Array& values);
+      godot_error write_floats(int64_t offset, const PackedFloat32Array& values);
+      godot_error write_doubles(int64_t offset, const PackedFloat64Array& values);
+      godot_error write_vector2s(int64_t offset, const PackedVector2Array& values);
+      godot_error write_vector3s(int64_t offset, const PackedVector3Array& values);
+      godot_error write_colors(int64_t offset, const PackedColorArray& values);
+      Ref<Image> to_image(int64_t offset, int64_t width, int64_t height, int64_t format) const;
+      godot_error update_texture(const Ref<ImageTexture>& texture, int64_t offset) const;
+      Array to_mesh_arrays(const Dictionary layout) const;
+      godot_error fill(int64_t offset, uint8_t value, int64_t length);
+      godot_error copy(int64_t destination, int64_t source, int64_t length);
+      int64_t compare(int64_t a, int64_t b, int64_t length) const;
+      int64_t find(const PackedByteArray& pattern, int64_t offset) const;
+      godot_error restore(const PackedByteArray& data);
       godot_error INTERFACE_GET_DATA override;
       godot_error INTERFACE_GET_PARTIAL_DATA override;
       godot_error INTERFACE_PUT_DATA override;
@@ -0,0 +1,336 @@
+#include <string>
+#include "wasm-module.h"
+#include "wasm.h"
+#include "defer.h"
+#include "store.h"
+#include "runtime.h"
+#include "extensions/wasi-p1.h"
+
+#define CACHE_DIGEST_SIZE 32 // SHA-256 digest prefixed to cached modules
+
+namespace godot {
+  namespace {
+    PackedByteArray serialize_module(const wasm_module_t* module) {
+      wasm_byte_vec_t serialized;
+      wasm_module_serialize(module, &serialized);
+      DEFER(wasm_byte_vec_delete(&serialized));
+      PackedByteArray bytes = PackedByteArray();
+      bytes.resize(serialized.size);
+      if (serialized.size) memcpy(bytes.ptrw(), serialized.data, serialized.size);
+      return bytes;
+    }
+
+    const godot_wasm::ExtensionFunction* find_extension_function(const String& key, const wasm_functype_t* func_type) {
+      const CharString name = key.utf8();
+      const godot_wasm::ExtensionFunction* function = godot_wasm::extension_find(godot_wasm::wasi_preview1_functions, name.get_data());
+      return function && godot_wasm::extension_signature_match(function, func_type) ? function : NULL;
+    }
+
+    wasm_module_t* deserialize_module(wasm_store_t* store, const PackedByteArray& bytes) {
+      if (bytes.is_empty()) return NULL;
+      wasm_byte_vec_t serialized;
+      DEFER(wasm_byte_vec_delete(&serialized));
+      wasm_byte_vec_new(&serialized, bytes.size(), (const wasm_byte_t*)BYTE_ARRAY_POINTER(bytes));
+      return wasm_module_deserialize(store, &serialized);
+    }
+
+    PackedByteArray sha256(const PackedByteArray& bytes) {
+      Ref<HashingContext> hashing = Ref<HashingContext>();
+      INSTANTIATE_REF(hashing);
+      hashing->start(HashingContext::HASH_SHA256);
+      hashing->update(bytes);
+      return hashing->finish();
+    }
+
+    wasm_module_t* read_cache(wasm_store_t* store, const String& path) {
+      // Cached modules are prefixed with a digest of the serialized module; deserializing native code is only safe if intact
+      const PackedByteArray file = FileAccess::get_file_as_bytes(path);
+      const PackedByteArray bytes = file.slice(CACHE_DIGEST_SIZE);
+      if (file.size() <= CACHE_DIGEST_SIZE || file.slice(0, CACHE_DIGEST_SIZE) != sha256(bytes)) {
+        PRINT_ERROR("Discarding corrupt module cache " + path);
+        DirAccess::remove_absolute(path);
+        return NULL; // Recompiled and rewritten by caller
+      }
+      return deserialize_module(store, bytes);
+    }
+
+    godot_error write_cache(const String& path, const PackedByteArray& bytes) {
+      FAIL_IF(bytes.is_empty(), "Module not serializable", ERR_UNAVAILABLE);
+      DirAccess::make_dir_recursive_absolute(path.get_base_dir());
+      // Written to a temporary file then renamed so readers never observe a partial module
+      // Temporary name is unique per thread as the same module may be compiled concurrently
+      const String temp = path + "." + String::num_uint64((uint64_t)THREAD_ID) + ".tmp";
+      Ref<FileAccess> file = FileAccess::open(temp, FileAccess::WRITE);
+      FAIL_IF(file.is_null(), "Failed to write module cache " + path, ERR_FILE_CANT_WRITE);
+      file->store_buffer(sha256(bytes));
+      file->store_buffer(bytes);
+      const godot_error error = file->get_error();
+      file->close();
+      if (error == OK && DirAccess::rename_absolute(temp, path) == OK) return OK;
+      DirAccess::remove_absolute(temp);
+      FAIL("Failed to write module cache " + path, ERR_FILE_CANT_WRITE);
+    }
+
+    String cache_path(const PackedByteArray& bytecode) {
+      // Serialized modules are only valid for the runtime and engine configuration that compiled them
+      Ref<HashingContext> hashing = Ref<HashingContext>();
+      INSTANTIATE_REF(hashing);
+      hashing->start(HashingContext::HASH_SHA256);
+      hashing->update(bytecode);
+      hashing->update(godot_wasm::engine_id().to_utf8_buffer());
+      const PackedByteArray digest = hashing->finish();
+      const char* hex = "0123456789abcdef";
+      String name = String();
+      for (int64_t i = 0; i < digest.size(); i++) name += String::chr(hex[digest[i] >> 4]) + String::chr(hex[digest[i] & 15]);
+      return godot_wasm::settings::module_cache_path().path_join(name + ".cwasm");
+    }
+
+    String decode_name(const wasm_name_t* name) {
+      return String(std::string(name->data, name->size).c_str());
+    }
+
+    Variant::Type get_value_type(const wasm_valkind_t& kind) {
+      switch (kind) {
+        case WASM_I32: case WASM_I64: return Variant::INT;
+        case WASM_F32: case WASM_F64: return Variant::FLOAT;
+        default: FAIL("Unsupported value kind", Variant::NIL);
+      }
+    }
+
+    wasm_externtype_t* get_extern_type(const wasm_module_t* module, uint16_t index, bool import) {
+      if (import) {
+        wasm_importtype_vec_t imports;
+        DEFER(wasm_importtype_vec_delete(&imports));
+        wasm_module_imports(module, &imports);
+        return wasm_externtype_copy((wasm_externtype_t*)wasm_importtype_type(imports.data[index]));
+      } else {
+        wasm_exporttype_vec_t exports;
+        DEFER(wasm_exporttype_vec_delete(&exports));
+        wasm_module_exports(module, &exports);
+        return wasm_externtype_copy((wasm_externtype_t*)wasm_exporttype_type(exports.data[index]));
+      }
+    }
+
+    Dictionary get_memory_limits(const wasm_module_t* module, const godot_wasm::ContextMemory* context) {
+      Dictionary dict;
+      if (context == NULL) return dict;
+      wasm_externtype_t* type = get_extern_type(module, context->index, context->import);
+      DEFER(wasm_externtype_delete(type));
+      wasm_memorytype_t* memory_type = wasm_externtype_as_memorytype(type);
+      auto limits = wasm_memorytype_limits(memory_type);
+      dict["min"] = limits->min * PAGE_SIZE;
+      dict["max"] = limits->max * PAGE_SIZE;
+      return dict;
+    }
+
+    Array get_extern_signature(const wasm_module_t* module, uint16_t index, bool import) {
+      // Grab the extern from module imports or exports
+      wasm_externtype_t* type = get_extern_type(module, index, import);
+      DEFER(wasm_externtype_delete(type));
+
+      // Generate a signature for extern
+      switch (wasm_externtype_kind(type)) {
+        case WASM_EXTERN_FUNC: {
+          wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
+          const wasm_valtype_vec_t* func_params = wasm_functype_params(func_type);
+          const wasm_valtype_vec_t* func_results = wasm_functype_results(func_type);
+          Array signature, param_types, result_types;
+          for (uint16_t i = 0; i < func_params->size; i++) param_types.append(get_value_type(wasm_valtype_kind(func_params->data[i])));
+          for (uint16_t i = 0; i < func_results->size; i++) result_types.append(get_value_type(wasm_valtype_kind(func_results->data[i])));
+          signature.append(param_types);
+          signature.append(result_types);
+          return signature;
+        } case WASM_EXTERN_GLOBAL: {
+          wasm_globaltype_t* global_type = wasm_externtype_as_globaltype((wasm_externtype_t*)type);
+          Array signature;
+          signature.append(get_value_type(wasm_valtype_kind(wasm_globaltype_content(global_type))));
+          signature.append(Variant(wasm_globaltype_mutability(global_type) == WASM_VAR ? true : false));
+          return signature;
+        } default: FAIL("Unsupported extern type", Array());
+      }
+    }
+  }
+
+  void WasmModule::REGISTRATION_METHOD() {
+    #ifdef GDNATIVE
+      register_method("compile", &WasmModule::compile);
+      register_method("compile_serialized", &WasmModule::compile_serialized);
+      register_method("serialize", &WasmModule::serialize);
+      register_method("inspect", &WasmModule::inspect);
+      register_method("instantiate", &WasmModule::instantiate);
+    #else
+      ClassDB::bind_method(D_METHOD("compile", "bytecode"), &WasmModule::compile);
+      ClassDB::bind_method(D_METHOD("compile_serialized", "bytes"), &WasmModule::compile_serialized);
+      ClassDB::bind_method(D_METHOD("serialize"), &WasmModule::serialize);
+      ClassDB::bind_method(D_METHOD("inspect"), &WasmModule::inspect);
+      ClassDB::bind_method(D_METHOD("instantiate", "import_map"), &WasmModule::instantiate);
+    #endif
+  }
+
+  WasmModule::WasmModule() {
+    module = NULL;
+    memory_context = NULL;
+    wasm_importtype_vec_new_empty(&imports);
+  }
+
+  WasmModule::~WasmModule() {
+    reset();
+  }
+
+  void WasmModule::_init() {}
+
+  void WasmModule::reset() {
+    if (memory_context) delete memory_context;
+    memory_context = NULL;
+    import_funcs.clear();
+    export_globals.clear();
+    export_funcs.clear();
+    wasm_importtype_vec_delete(&imports);
+    wasm_importtype_vec_new_empty(&imports);
+    if (module) wasm_module_delete(module);
+    module = NULL;
+  }
+
+  godot_error WasmModule::compile(PackedByteArray bytecode) {
+    FAIL_IF(module != NULL, "Module already compiled", ERR_ALREADY_IN_USE);
+
+    // Compiled modules belong to the engine; transient store allows compilation off the main thread
+    wasm_store_t* store = wasm_store_new(ENGINE);
+    DEFER(wasm_store_delete(store));
+
+    // Attempt to skip compilation using a previously serialized module
+    const String cache = godot_wasm::settings::module_cache() ? cache_path(bytecode) : String();
+    if (!cache.is_empty() && FileAccess::file_exists(cache)) module = read_cache(store, cache);
+
+    if (module == NULL) {
+      // Load binary
+      wasm_byte_vec_t wasm_bytes;
+      DEFER(wasm_byte_vec_delete(&wasm_bytes));
+      wasm_byte_vec_new(&wasm_bytes, bytecode.size(), (const wasm_byte_t*)BYTE_ARRAY_POINTER(bytecode));
+
+      // Compile; runtimes validate during compilation so a separate pass is only needed to classify failure
+      module = wasm_module_new(store, &wasm_bytes);
+      if (module == NULL) {
+        FAIL_IF(!wasm_module_validate(store, &wasm_bytes), "Invalid binary", ERR_INVALID_DATA);
+        FAIL("Compilation failed", ERR_COMPILATION_FAILED);
+      }
+
+      // Populate cache; failure to do so is non-fatal
+      if (!cache.is_empty()) write_cache(cache, serialize_module(module));
+    }
+
+    // Map names to export indices
+    if (map_names() != OK) {
+      reset();
+      FAIL("Failed to parse module imports or exports", ERR_COMPILATION_FAILED);
+    }
+
+    return OK;
+  }
+
+  godot_error WasmModule::compile_serialized(PackedByteArray bytes) {
+    FAIL_IF(module != NULL, "Module already compiled", ERR_ALREADY_IN_USE);
+
+    // Deserialize precompiled module
+    wasm_store_t* store = wasm_store_new(ENGINE);
+    DEFER(wasm_store_delete(store));
+    module = deserialize_module(store, bytes);
+    FAIL_IF(module == NULL, "Deserialization failed", ERR_INVALID_DATA);
+
+    // Map names to export indices
+    if (map_names() != OK) {
+      reset();
+      FAIL("Failed to parse module imports or exports", ERR_COMPILATION_FAILED);
+    }
+
+    return OK;
+  }
+
+  PackedByteArray WasmModule::serialize() const {
+    FAIL_IF(module == NULL, "Serialization failed", PackedByteArray());
+    return serialize_module(module);
+  }
+
+  Dictionary WasmModule::inspect() const {
+    // Validate module
+    FAIL_IF(module == NULL, "Inspection failed", Dictionary());
+
+    // Module extern names and signatures
+    Dictionary import_func_sigs, export_global_sigs, export_func_sigs;
+    for (const auto &tuple: import_funcs) import_func_sigs[tuple.first] = get_extern_signature(module, tuple.second.index, true);
+    for (const auto &tuple: export_globals) export_global_sigs[tuple.first] = get_extern_signature(module, tuple.second.index, false);
+    for (const auto &tuple: export_funcs) export_func_sigs[tuple.first] = get_extern_signature(module, tuple.second.index, false);
+
+    // Module info dictionary
+    Dictionary dict;
+    dict["import_functions"] = import_func_sigs;
+    dict["export_globals"] = export_global_sigs;
+    dict["export_functions"] = export_func_sigs;
+    Dictionary dict_memory = get_memory_limits(module, memory_context);
+    if (memory_context != NULL) dict_memory["import"] = memory_context->import;
+    dict["memory"] = dict_memory;
+    return dict;
+  }
+
+  Ref<Wasm> WasmModule::instantiate(const Dictionary import_map) {
+    // New instance sharing this module's compiled code
+    FAIL_IF(module == NULL, "Not compiled", Ref<Wasm>());
+    Ref<Wasm> wasm;
+    INSTANTIATE_REF(wasm);
+    wasm->set_module(Ref<WasmModule>(this));
+    if (wasm->instantiate(import_map) != OK) return Ref<Wasm>();
+    return wasm;
+  }
+
+  godot_error WasmModule::map_names() {
+    // Module imports; types retained for creating import functions on instantiation
+    wasm_importtype_vec_delete(&imports);
+    wasm_module_imports(module, &imports);
+    for (uint16_t i = 0; i < imports.size; i++) {
+      const wasm_externtype_t* type = wasm_importtype_type(imports.data[i]);
+      const wasm_externkind_t kind = wasm_externtype_kind(type);
+      const String key = decode_name(wasm_importtype_module(imports.data[i])) + "." + decode_name(wasm_importtype_name(imports.data[i]));
+      switch (kind) {
+        case WASM_EXTERN_FUNC: {
+          const wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
+          import_funcs.emplace(key, godot_wasm::ContextFuncImport(i, func_type, find_extension_function(key, func_type)));
+          break;
+        } case WASM_EXTERN_MEMORY:
+          memory_context = new godot_wasm::ContextMemory(i, true, wasm_externtype_as_memorytype((wasm_externtype_t*)type));
+          break;
+        case WASM_EXTERN_TABLE:
+          WARN_PRINT("Tables not implemented for import " + key);
+          break;
+        default: WARN_PRINT("Type not implemented for import " + key);
+      }
+    }
+
+    // Module exports
+    wasm_exporttype_vec_t exports;
+    DEFER(wasm_exporttype_vec_delete(&exports));
+    wasm_module_exports(module, &exports);
+    for (uint16_t i = 0; i < exports.size; i++) {
+      const wasm_externtype_t* type = wasm_exporttype_type(exports.data[i]);
+      const wasm_externkind_t kind = wasm_externtype_kind(type);
+      const String key = decode_name(wasm_exporttype_name(exports.data[i]));
+      switch (kind) {
+        case WASM_EXTERN_FUNC: {
+          const wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
+          export_funcs.emplace(key, godot_wasm::ContextFuncExport(i, func_type));
+          break;
+        } case WASM_EXTERN_GLOBAL:
+          export_globals.emplace(key, godot_wasm::ContextGlobalExport(i));
+          break;
+        case WASM_EXTERN_MEMORY:
+          if (memory_context == NULL) memory_context = new godot_wasm::ContextMemory(i, false, wasm_externtype_as_memorytype((wasm_externtype_t*)type)); // Favour import memory
+          break;
+        case WASM_EXTERN_TABLE:
+          WARN_PRINT("Tables not implemented for export " + key);
+          break;
+        default: WARN_PRINT("Type not implemented for export " + key);
+      }
+    }
+
+    return OK;
+  }
+}
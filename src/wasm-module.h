@@ -0,0 +1,39 @@
+#ifndef WASM_MODULE_H
+#define WASM_MODULE_H
+
+#include <map>
+#include <wasm.h>
+#include "defs.h"
+#include "context.h"
+
+namespace godot {
+  class Wasm; // Forward declare to avoid circular dependency
+
+  class WasmModule: public RefCounted {
+    GDCLASS(WasmModule, RefCounted);
+    friend class Wasm; // Instances copy module metadata and share compiled code
+
+    private:
+      wasm_module_t* module;
+      wasm_importtype_vec_t imports; // Import types referenced by import contexts
+      godot_wasm::ContextMemory* memory_context;
+      std::map<String, godot_wasm::ContextFuncImport> import_funcs;
+      std::map<String, godot_wasm::ContextGlobalExport> export_globals;
+      std::map<String, godot_wasm::ContextFuncExport> export_funcs;
+      void reset();
+      godot_error map_names();
+
+    public:
+      static void REGISTRATION_METHOD();
+      WasmModule();
+      ~WasmModule();
+      void _init();
+      godot_error compile(PackedByteArray bytecode);
+      godot_error compile_serialized(PackedByteArray bytes);
+      PackedByteArray serialize() const;
+      Dictionary inspect() const;
+      Ref<Wasm> instantiate(const Dictionary import_map);
+  };
+}
+
+#endif
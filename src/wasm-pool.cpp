@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cstring>
+#include "wasm-pool.h"
+
+#define CHUNKS_PER_INSTANCE 8 // Finer chunks balance uneven rows at the cost of per chunk overhead
+
+namespace godot {
+  namespace {
+    int64_t packed_size(const Variant& args) {
+      switch (args.get_type()) {
+        case Variant::PACKED_INT64_ARRAY: return args.operator PackedInt64Array().size();
+        case Variant::PACKED_FLOAT64_ARRAY: return args.operator PackedFloat64Array().size();
+        default: return -1;
+      }
+    }
+
+    template <typename T> Variant packed_gather(const std::vector<Variant>& chunks) {
+      int64_t size = 0;
+      for (const auto &chunk: chunks) size += chunk.operator T().size();
+      T results;
+      results.resize(size);
+      auto* out = results.ptrw();
+      for (const auto &chunk: chunks) {
+        const T values = chunk;
+        if (values.size()) memcpy(out, values.ptr(), values.size() * sizeof(*out));
+        out += values.size();
+      }
+      return results;
+    }
+  }
+
+  void WasmPool::REGISTRATION_METHOD() {
+    #ifdef GDNATIVE
+      register_method("instantiate", &WasmPool::instantiate);
+      register_method("get_size", &WasmPool::get_size);
+      register_method("get_instance", &WasmPool::get_instance);
+      register_method("dispatch", &WasmPool::dispatch);
+    #else
+      ClassDB::bind_method(D_METHOD("instantiate", "module", "size", "import_map"), &WasmPool::instantiate);
+      ClassDB::bind_method(D_METHOD("get_size"), &WasmPool::get_size);
+      ClassDB::bind_method(D_METHOD("get_instance", "index"), &WasmPool::get_instance);
+      ClassDB::bind_method(D_METHOD("dispatch", "name", "args", "stride"), &WasmPool::dispatch);
+    #endif
+  }
+
+  WasmPool::WasmPool() {
+    dispatch_stride = 0;
+    chunk_size = 0;
+    next_chunk = 0;
+    dispatching = false;
+  }
+
+  WasmPool::~WasmPool() {}
+
+  void WasmPool::_init() {}
+
+  godot_error WasmPool::instantiate(const Ref<WasmModule> &module, int64_t size, const Dictionary import_map) {
+    FAIL_IF(dispatching, "Dispatch in progress", ERR_BUSY);
+    FAIL_IF(module.is_null(), "Invalid module", ERR_INVALID_PARAMETER);
+    FAIL_IF(size <= 0, "Invalid pool size", ERR_INVALID_PARAMETER);
+    instances.clear();
+
+    // Each instance has its own store so may run on its own thread
+    for (int64_t i = 0; i < size; i++) {
+      const Ref<Wasm> wasm = module->instantiate(import_map);
+      if (wasm.is_null()) {
+        instances.clear();
+        FAIL("Failed to instantiate pool", ERR_CANT_CREATE);
+      }
+      instances.push_back(wasm);
+    }
+
+    return OK;
+  }
+
+  int64_t WasmPool::get_size() const {
+    return instances.size();
+  }
+
+  Ref<Wasm> WasmPool::get_instance(int64_t index) const {
+    FAIL_IF(index < 0 || index >= (int64_t)instances.size(), "Invalid instance index", Ref<Wasm>());
+    return instances[index];
+  }
+
+  Variant WasmPool::dispatch(String name, Variant args, int64_t stride) {
+    FAIL_IF(instances.empty(), "Not instantiated", NULL_VARIANT);
+    FAIL_IF(dispatching, "Dispatch in progress", NULL_VARIANT);
+    FAIL_IF(stride <= 0, "Invalid stride", NULL_VARIANT);
+    const int64_t size = packed_size(args);
+    FAIL_IF(size < 0, "Unsupported argument array type", NULL_VARIANT);
+    FAIL_IF(size % stride != 0, "Argument count not a multiple of stride", NULL_VARIANT);
+
+    // Split rows into chunks claimed by instances as they become idle
+    const int64_t rows = size / stride;
+    const int64_t chunks = std::min(rows, (int64_t)instances.size() * CHUNKS_PER_INSTANCE);
+    if (chunks <= 1) return instances[0]->function_batch(name, args, stride); // Not worth distributing
+    const int64_t rows_per_chunk = (rows + chunks - 1) / chunks;
+    dispatch_name = name;
+    dispatch_args = args;
+    dispatch_stride = stride;
+    chunk_size = rows_per_chunk * stride;
+    chunk_results.assign((size + chunk_size - 1) / chunk_size, NULL_VARIANT);
+    next_chunk = 0;
+
+    // Calling thread blocks until all chunks are complete
+    dispatching = true;
+    const int64_t workers = std::min((int64_t)instances.size(), (int64_t)chunk_results.size());
+    WorkerThreadPool* pool = WorkerThreadPool::get_singleton();
+    const int64_t task = pool->add_group_task(callable_mp(this, &WasmPool::dispatch_worker), workers, -1, true, "Dispatch Wasm function " + name);
+    pool->wait_for_group_task_completion(task);
+    dispatching = false;
+
+    // Gather chunk results in order
+    std::vector<Variant> results;
+    results.swap(chunk_results);
+    dispatch_args = NULL_VARIANT;
+    for (const auto &chunk: results) FAIL_IF(chunk.get_type() == Variant::NIL, "Failed dispatching function " + name, NULL_VARIANT);
+    return results[0].get_type() == Variant::PACKED_INT64_ARRAY
+      ? packed_gather<PackedInt64Array>(results)
+      : packed_gather<PackedFloat64Array>(results);
+  }
+
+  void WasmPool::dispatch_worker(uint32_t index) {
+    // Runs on a worker thread; instance is used exclusively by this worker for the duration of the dispatch
+    const Ref<Wasm>& wasm = instances[index];
+    const int64_t size = packed_size(dispatch_args);
+    for (int64_t chunk = next_chunk++; chunk < (int64_t)chunk_results.size(); chunk = next_chunk++) {
+      // Chunks are read in place from the shared argument array rather than copied
+      const int64_t begin = chunk * chunk_size;
+      chunk_results[chunk] = wasm->function_batch_range(dispatch_name, dispatch_args, dispatch_stride, begin, std::min(begin + chunk_size, size));
+    }
+  }
+}
@@ -0,0 +1,36 @@
+#ifndef WASM_POOL_H
+#define WASM_POOL_H
+
+#include <atomic>
+#include <vector>
+#include "defs.h"
+#include "wasm.h"
+
+namespace godot {
+  class WasmPool: public RefCounted {
+    GDCLASS(WasmPool, RefCounted);
+
+    private:
+      std::vector<Ref<Wasm>> instances;
+      String dispatch_name; // Dispatch state; valid during dispatch only
+      Variant dispatch_args;
+      int64_t dispatch_stride;
+      int64_t chunk_size; // Argument values per chunk
+      std::vector<Variant> chunk_results;
+      std::atomic<int64_t> next_chunk; // Next chunk to be claimed by an idle instance
+      bool dispatching;
+      void dispatch_worker(uint32_t index);
+
+    public:
+      static void REGISTRATION_METHOD();
+      WasmPool();
+      ~WasmPool();
+      void _init();
+      godot_error instantiate(const Ref<WasmModule> &module, int64_t size, const Dictionary import_map);
+      int64_t get_size() const;
+      Ref<Wasm> get_instance(int64_t index) const;
+      Variant dispatch(String name, Variant args, int64_t stride);
+  };
+}
+
+#endif
@@ -1,44 +1,20 @@
 #include <string>
 #include <vector>
+#include <array>
+#include <type_traits>
+#include <utility>
+#include <cstring>
 #include "wasm.h"
-#include "extensions/wasi-p1.h"
+#include "context.h"
+#include "extensions/extension.h"
 #include "defer.h"
 #include "store.h"
+#include "preinitializer.h"
 
-namespace godot {
-  namespace godot_wasm {
-    struct ContextExtern {
-      uint16_t index; // Index within module imports/exports
-      ContextExtern(uint16_t i) { index = i; }
-    };
-
-    struct ContextFuncImport: public ContextExtern {
-      ObjectID target; // The ID of the object on which to invoke callback method
-      String method; // External name; doesn't necessarily match import name
-      std::vector<wasm_valkind_t> results; // Return types
-      ContextFuncImport(uint16_t i, const wasm_functype_t* func_type): ContextExtern(i) {
-        const wasm_valtype_vec_t* func_results = wasm_functype_results(func_type);
-        for (uint16_t i = 0; i < func_results->size; i++) results.push_back(wasm_valtype_kind(func_results->data[i]));
-      }
-    };
-
-    struct ContextFuncExport: public ContextExtern {
-      size_t return_count; // Number of return values
-      std::vector<wasm_valkind_t> params; // Param types
-      ContextFuncExport(uint16_t i, const wasm_functype_t* func_type): ContextExtern(i) {
-        const wasm_valtype_vec_t* func_params = wasm_functype_params(func_type);
-        const wasm_valtype_vec_t* func_results = wasm_functype_results(func_type);
-        for (uint16_t i = 0; i < func_params->size; i++) params.push_back(wasm_valtype_kind(func_params->data[i]));
-        return_count = func_results->size;
-      }
-    };
-
-    struct ContextMemory: public ContextExtern {
-      bool import; // Import; not export
-      ContextMemory(uint16_t i, bool import): ContextExtern(i), import(import) {}
-    };
-  }
+#define OUTPUT_BUFFER_MAX 4096 // Incomplete line length at which guest output is flushed regardless
+#define TYPED_CALLBACK_PARAMS 2 // Maximum param count of import wrappers specialized on value kinds
 
+namespace godot {
   namespace {
     template <typename T> void unset(T*& p, void (*f)(T*)) {
       if (p == NULL) return;
@@ -70,7 +46,7 @@ namespace godot {
       }
     }
 
-    wasm_val_t encode_variant(Variant variant, wasm_valkind_t kind) {
+    wasm_val_t encode_variant(const Variant& variant, wasm_valkind_t kind) {
       wasm_val_t value;
       value.kind = kind;
       switch (variant.get_type()) {
@@ -101,8 +77,27 @@ namespace godot {
       }
     }
 
-    String decode_name(const wasm_name_t* name) {
-      return String(std::string(name->data, name->size).c_str());
+    template <typename T> inline wasm_val_t encode_number(T number, wasm_valkind_t kind) {
+      wasm_val_t value;
+      value.kind = kind;
+      switch (kind) {
+        case WASM_I32: value.of.i32 = (int32_t)number; break;
+        case WASM_I64: value.of.i64 = (int64_t)number; break;
+        case WASM_F32: value.of.f32 = (float32_t)number; break;
+        case WASM_F64: value.of.f64 = (float64_t)number; break;
+        default: value.kind = WASM_EXTERNREF; value.of.ref = NULL;
+      }
+      return value;
+    }
+
+    template <typename T> inline T decode_number(const wasm_val_t& value) {
+      switch (value.kind) {
+        case WASM_I32: return (T)value.of.i32;
+        case WASM_I64: return (T)value.of.i64;
+        case WASM_F32: return (T)value.of.f32;
+        case WASM_F64: return (T)value.of.f64;
+        default: return (T)0;
+      }
     }
 
     inline Variant dict_safe_get(const Dictionary &d, String k, Variant e) {
@@ -130,117 +125,351 @@ namespace godot {
       } else return ERR_INVALID_DATA;
     }
 
-    Variant::Type get_value_type(const wasm_valkind_t& kind) {
-      switch (kind) {
-        case WASM_I32: case WASM_I64: return Variant::INT;
-        case WASM_F32: case WASM_F64: return Variant::FLOAT;
-        default: FAIL("Unsupported value kind", Variant::NIL);
-      }
+    wasm_trap_t* trap(const char* message) {
+      wasm_message_t trap_message;
+      wasm_name_new_from_string_nt(&trap_message, message);
+      return wasm_trap_new(NULL, &trap_message);
     }
 
-    wasm_externtype_t* get_extern_type(const wasm_module_t* module, uint16_t index, bool import) {
-      if (import) {
-        wasm_importtype_vec_t imports;
-        DEFER(wasm_importtype_vec_delete(&imports));
-        wasm_module_imports(module, &imports);
-        return wasm_externtype_copy((wasm_externtype_t*)wasm_importtype_type(imports.data[index]));
-      } else {
-        wasm_exporttype_vec_t exports;
-        DEFER(wasm_exporttype_vec_delete(&exports));
-        wasm_module_exports(module, &exports);
-        return wasm_externtype_copy((wasm_externtype_t*)wasm_exporttype_type(exports.data[index]));
-      }
+    inline bool target_valid(const Callable& target) {
+      // Object method targets may have been freed; custom callables e.g. lambdas validate themselves
+      return target.is_standard() ? target.get_object() != nullptr : target.is_valid();
     }
 
-    Dictionary get_memory_limits(const wasm_module_t* module, const godot_wasm::ContextMemory* context) {
-      Dictionary dict;
-      if (context == NULL) return dict;
-      wasm_externtype_t* type = get_extern_type(module, context->index, context->import);
-      DEFER(wasm_externtype_delete(type));
-      wasm_memorytype_t* memory_type = wasm_externtype_as_memorytype(type);
-      auto limits = wasm_memorytype_limits(memory_type);
-      dict["min"] = limits->min * PAGE_SIZE;
-      dict["max"] = limits->max * PAGE_SIZE;
-      return dict;
-    }
-
-    Array get_extern_signature(const wasm_module_t* module, uint16_t index, bool import) {
-      // Grab the extern from module imports or exports
-      wasm_externtype_t* type = get_extern_type(module, index, import);
-      DEFER(wasm_externtype_delete(type));
-
-      // Generate a signature for extern
-      switch (wasm_externtype_kind(type)) {
-        case WASM_EXTERN_FUNC: {
-          wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
-          const wasm_valtype_vec_t* func_params = wasm_functype_params(func_type);
-          const wasm_valtype_vec_t* func_results = wasm_functype_results(func_type);
-          Array signature, param_types, result_types;
-          for (uint16_t i = 0; i < func_params->size; i++) param_types.append(get_value_type(wasm_valtype_kind(func_params->data[i])));
-          for (uint16_t i = 0; i < func_results->size; i++) result_types.append(get_value_type(wasm_valtype_kind(func_results->data[i])));
-          signature.append(param_types);
-          signature.append(result_types);
-          return signature;
-        } case WASM_EXTERN_GLOBAL: {
-          wasm_globaltype_t* global_type = wasm_externtype_as_globaltype((wasm_externtype_t*)type);
-          Array signature;
-          signature.append(get_value_type(wasm_valtype_kind(wasm_globaltype_content(global_type))));
-          signature.append(Variant(wasm_globaltype_mutability(global_type) == WASM_VAR ? true : false));
-          return signature;
-        } default: FAIL("Unsupported extern type", Array());
-      }
+    inline void resolve_target(godot_wasm::ContextFuncImport* context, const Callable& target) {
+      // Object method targets are called directly via object and method name; avoids per call Callable resolution
+      context->object = target.is_standard() ? ObjectID(target.get_object_id()) : ObjectID();
+      context->method = target.is_standard() ? target.get_method() : StringName();
+      context->target = target.is_standard() ? Callable() : target;
     }
 
-    wasm_trap_t* trap(const char* message) {
-      wasm_message_t trap_message;
-      wasm_name_new_from_string_nt(&trap_message, message);
-      return wasm_trap_new(NULL, &trap_message);
+    bool invoke_target(const godot_wasm::ContextFuncImport* context, const Variant** args, int count, Variant& result) {
+      // Returns false only if target has been freed; other call errors are reported and yield a null result
+      CALL_ERROR error = {};
+      if (context->object.is_valid()) {
+        Object* object = INSTANCE_FROM_ID(context->object); // Object may have been freed since instantiation
+        FAIL_IF(object == nullptr, "Failed to retrieve import function target", false);
+        OBJECT_CALLP(object, context->method, args, count, result, error);
+        if (error.error == CALL_ERROR_METHOD) FAIL("Invalid call to '" + object->get_class() + "::" + String(context->method) + "': Method not found", true);
+      } else CALLABLE_CALLP(context->target, args, count, result, error);
+      FAIL_IF(error.error == CALL_ERROR_INSTANCE, "Failed to retrieve import function target", false);
+      FAIL_IF(error.error != CALL_OK, "Invalid call to import function target", true);
+      return true;
+    }
+
+    bool call_target(const godot_wasm::ContextFuncImport* context, const Variant** args, int count, Variant& result) {
+      // Import targets are called on the main thread; resumable calls hand them off from their worker thread
+      WasmCall* call = WasmCall::get_current();
+      if (call == NULL) return invoke_target(context, args, count, result);
+      bool valid = false;
+      call->call_main([&]() { valid = invoke_target(context, args, count, result); });
+      return valid;
     }
 
     wasm_trap_t* callback_wrapper(void* env, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
       // This is invoked by Wasm module calls to imported functions
       // Must be free function so context is passed via the env void pointer
       godot_wasm::ContextFuncImport* context = (godot_wasm::ContextFuncImport*)env;
-      Array params = Array();
-      // TODO: Check if args and results match expected sizes
-      for (uint16_t i = 0; i < args->size; i++) params.push_back(decode_variant(args->data[i]));
-      Object* target = INSTANCE_FROM_ID(context->target);
-      FAIL_IF(target == nullptr, "Failed to retrieve import function target", trap("Failed to retrieve import function target\0"));
-      Variant variant = target->callv(context->method, params);
+      std::vector<Variant> params(args->size);
+      std::vector<const Variant*> pointers(args->size);
+      // Argument count and kinds are checked by the runtime against the import type; results by extraction
+      for (uint16_t i = 0; i < args->size; i++) {
+        params[i] = decode_variant(args->data[i]);
+        pointers[i] = &params[i];
+      }
+      Variant variant;
+      if (!call_target(context, pointers.data(), args->size, variant)) return trap("Failed to retrieve import function target\0");
+      godot_error error = extract_results(variant, context, results);
+      if (error) FAIL("Extracting import function results failed", trap("Extracting import function results failed\0"));
+      return NULL;
+    }
+
+    template <size_t N, size_t... I> inline bool call_fixed(const godot_wasm::ContextFuncImport* context, const wasm_val_vec_t* args, Variant& result, std::index_sequence<I...>) {
+      const std::array<Variant, N> params = { decode_variant(args->data[I])... };
+      std::array<const Variant*, N> pointers = { &params[I]... };
+      return call_target(context, pointers.data(), N, result);
+    }
+
+    template <size_t N> wasm_trap_t* callback_fixed(void* env, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      // Specialization of callback wrapper for a fixed number of params
+      // Arguments are passed on the stack rather than via heap allocated vectors
+      godot_wasm::ContextFuncImport* context = (godot_wasm::ContextFuncImport*)env;
+      Variant variant;
+      if (!call_fixed<N>(context, args, variant, std::make_index_sequence<N>())) return trap("Failed to retrieve import function target\0");
       godot_error error = extract_results(variant, context, results);
       if (error) FAIL("Extracting import function results failed", trap("Extracting import function results failed\0"));
       return NULL;
     }
+
+    // Value kinds of typed callback wrappers; decode and encode without switching on kind or boxing results in arrays
+    struct KindNone {};
+    struct KindI32 {
+      static inline Variant decode(const wasm_val_t& value) { return Variant(value.of.i32); }
+      static inline bool encode(const Variant& variant, wasm_val_t& value) {
+        if (variant.get_type() != Variant::INT) return false;
+        value.kind = WASM_I32;
+        value.of.i32 = (int32_t)variant;
+        return true;
+      }
+    };
+    struct KindI64 {
+      static inline Variant decode(const wasm_val_t& value) { return Variant(value.of.i64); }
+      static inline bool encode(const Variant& variant, wasm_val_t& value) {
+        if (variant.get_type() != Variant::INT) return false;
+        value.kind = WASM_I64;
+        value.of.i64 = (int64_t)variant;
+        return true;
+      }
+    };
+    struct KindF32 {
+      static inline Variant decode(const wasm_val_t& value) { return Variant(value.of.f32); }
+      static inline bool encode(const Variant& variant, wasm_val_t& value) {
+        if (variant.get_type() != Variant::FLOAT) return false;
+        value.kind = WASM_F32;
+        value.of.f32 = (float32_t)variant;
+        return true;
+      }
+    };
+    struct KindF64 {
+      static inline Variant decode(const wasm_val_t& value) { return Variant(value.of.f64); }
+      static inline bool encode(const Variant& variant, wasm_val_t& value) {
+        if (variant.get_type() != Variant::FLOAT) return false;
+        value.kind = WASM_F64;
+        value.of.f64 = (float64_t)variant;
+        return true;
+      }
+    };
+
+    template <typename R, typename... P, size_t... I> inline wasm_trap_t* call_typed(const godot_wasm::ContextFuncImport* context, const wasm_val_vec_t* args, wasm_val_vec_t* results, std::index_sequence<I...>) {
+      const std::array<Variant, sizeof...(P)> params = { P::decode(args->data[I])... };
+      std::array<const Variant*, sizeof...(P)> pointers = { &params[I]... };
+      Variant variant;
+      if (!call_target(context, pointers.data(), sizeof...(P), variant)) return trap("Failed to retrieve import function target\0");
+      if constexpr (!std::is_same_v<R, KindNone>) {
+        if (R::encode(variant, results->data[0])) return NULL;
+        // Result of unexpected type or wrapped in array; defer to generic extraction and its error reporting
+        godot_error error = extract_results(variant, context, results);
+        if (error) FAIL("Extracting import function results failed", trap("Extracting import function results failed\0"));
+      }
+      return NULL;
+    }
+
+    template <typename R, typename... P> wasm_trap_t* callback_typed(void* env, const wasm_val_vec_t* args, wasm_val_vec_t* results) {
+      // Specialization of callback wrapper for fixed param and result kinds
+      return call_typed<R, P...>((godot_wasm::ContextFuncImport*)env, args, results, std::index_sequence_for<P...>());
+    }
+
+    template <typename R, typename... P> wasm_func_callback_with_env_t get_callback_typed(const wasm_valtype_vec_t* params) {
+      // Selects typed wrapper by appending one param kind at a time; NULL if signature not covered
+      if constexpr (sizeof...(P) < TYPED_CALLBACK_PARAMS) {
+        if (params->size > sizeof...(P)) switch (wasm_valtype_kind(params->data[sizeof...(P)])) {
+          case WASM_I32: return get_callback_typed<R, P..., KindI32>(params);
+          case WASM_I64: return get_callback_typed<R, P..., KindI64>(params);
+          case WASM_F32: return get_callback_typed<R, P..., KindF32>(params);
+          case WASM_F64: return get_callback_typed<R, P..., KindF64>(params);
+          default: return NULL;
+        }
+      }
+      return params->size == sizeof...(P) ? callback_typed<R, P...> : NULL;
+    }
+
+    wasm_func_callback_with_env_t get_callback_typed(const wasm_functype_t* func_type) {
+      const wasm_valtype_vec_t* params = wasm_functype_params(func_type);
+      const wasm_valtype_vec_t* results = wasm_functype_results(func_type);
+      if (results->size == 0) return get_callback_typed<KindNone>(params);
+      if (results->size > 1) return NULL;
+      switch (wasm_valtype_kind(results->data[0])) {
+        case WASM_I32: return get_callback_typed<KindI32>(params);
+        case WASM_I64: return get_callback_typed<KindI64>(params);
+        case WASM_F32: return get_callback_typed<KindF32>(params);
+        case WASM_F64: return get_callback_typed<KindF64>(params);
+        default: return NULL;
+      }
+    }
+
+    wasm_func_callback_with_env_t get_callback_wrapper(const wasm_functype_t* func_type) {
+      // Prefer wrapper specialized on value kinds, then on param count, then generic
+      const wasm_func_callback_with_env_t typed = get_callback_typed(func_type);
+      if (typed != NULL) return typed;
+      switch (wasm_functype_params(func_type)->size) {
+        case 0: return callback_fixed<0>;
+        case 1: return callback_fixed<1>;
+        case 2: return callback_fixed<2>;
+        case 3: return callback_fixed<3>;
+        case 4: return callback_fixed<4>;
+        default: return callback_wrapper;
+      }
+    }
+
+    inline godot_error fault_error(const wasm_instance_t* instance) {
+      // Budget exhaustion is distinguished from other traps e.g. to retry work on a later frame
+      return godot_wasm::Store::instance().metered && godot_wasm::budget_exhausted(instance) ? ERR_TIMEOUT : FAILED;
+    }
+
+    inline String fault_message(godot_error error, const String& name) {
+      return (error == ERR_TIMEOUT ? "Execution budget exceeded calling function " : "Failed calling function ") + name;
+    }
+
+    template <typename A, typename R> Variant call_batch(const wasm_instance_t* instance, const godot_wasm::ContextFuncExport& context, const String& name, const A& args, int64_t stride, int64_t begin, int64_t end, const bool& exiting, godot_error& error) {
+      // Arguments are laid out in rows of stride values; unused trailing values in each row are ignored
+      // Rows are read in place from the range [begin, end) of values; negative end is the end of the array
+      if (end < 0) end = args.size();
+      FAIL_IF(begin < 0 || begin > end || end > args.size(), "Invalid argument range", NULL_VARIANT);
+      FAIL_IF((end - begin) % stride != 0, "Argument count not a multiple of stride", NULL_VARIANT);
+      const size_t rows = (end - begin) / stride;
+      const size_t param_count = context.params.size();
+      const size_t return_count = context.return_count;
+      R results;
+      results.resize(rows * return_count);
+      const auto* in = args.ptr() + begin;
+      auto* out = results.ptrw();
+      const wasm_val_vec_t f_args = { context.args.size(), context.args.data() };
+      wasm_val_vec_t f_results = { context.results.size(), context.results.data() };
+
+      for (size_t row = 0; row < rows; row++) {
+        for (size_t i = 0; i < param_count; i++) context.args[i] = encode_number(in[i], context.params[i]);
+        wasm_trap_t* fault = wasm_func_call(context.func, &f_args, &f_results);
+        if (fault) {
+          wasm_trap_delete(fault);
+          if (exiting) { error = OK; return NULL_VARIANT; } // Guest exit unwinds via trap
+          error = fault_error(instance);
+          FAIL(fault_message(error, name) + " at row " + String::num_int64(row), NULL_VARIANT);
+        }
+        for (size_t i = 0; i < return_count; i++) out[i] = decode_number<typename std::decay<decltype(*out)>::type>(context.results[i]);
+        in += stride;
+        out += return_count;
+      }
+
+      error = OK;
+      return results;
+    }
+
+    wasm_valkind_t get_global_kind(const wasm_global_t* global, bool* variable = NULL) {
+      wasm_globaltype_t* type = wasm_global_type(global);
+      DEFER(wasm_globaltype_delete(type));
+      if (variable) *variable = wasm_globaltype_mutability(type) == WASM_VAR;
+      return wasm_valtype_kind(wasm_globaltype_content(type));
+    }
+
+    inline const Variant& get_arg(const Array& args, uint16_t i) {
+      return args[i];
+    }
+
+    inline const Variant& get_arg(const Variant** args, uint16_t i) {
+      return *args[i];
+    }
+
+    template <typename T> Variant call_export(const wasm_instance_t* instance, const godot_wasm::ContextFuncExport& context, const String& name, const T& args, size_t count, const bool& exiting, godot_error& error) {
+      // Retrieve exported function
+      const wasm_func_t* func = context.func;
+      FAIL_IF(func == NULL, "Failed to retrieve function export " + name, NULL_VARIANT);
+
+      // Validate argument count
+      FAIL_IF(context.params.size() != count, "Incorrect number of arguments supplied", NULL_VARIANT);
+
+      // Construct args in preallocated scratch space
+      for (uint16_t i = 0; i < count; i++) {
+        context.args[i] = encode_variant(get_arg(args, i), context.params[i]);
+        FAIL_IF(context.args[i].kind == WASM_EXTERNREF, "Invalid argument type", NULL_VARIANT);
+      }
+      const wasm_val_vec_t f_args = { context.args.size(), context.args.data() };
+      wasm_val_vec_t f_results = { context.results.size(), context.results.data() };
+
+      // Call function
+      wasm_trap_t* fault = wasm_func_call(func, &f_args, &f_results);
+      if (fault) {
+        wasm_trap_delete(fault);
+        if (exiting) { error = OK; return NULL_VARIANT; } // Guest exit unwinds via trap
+        error = fault_error(instance);
+        FAIL(fault_message(error, name), NULL_VARIANT);
+      }
+
+      // Extract result(s)
+      error = OK;
+      if (context.return_count == 0) return NULL_VARIANT;
+      if (context.return_count == 1) return decode_variant(context.results[0]);
+      Array results = Array();
+      for (uint16_t i = 0; i < context.return_count; i++) results.append(decode_variant(context.results[i]));
+      return results;
+    }
   }
 
   void Wasm::REGISTRATION_METHOD() {
     #ifdef GDNATIVE
       register_method("compile", &Wasm::compile);
+      register_method("compile_serialized", &Wasm::compile_serialized);
+      register_method("compile_async", &Wasm::compile_async);
+      register_method("is_compiling", &Wasm::is_compiling);
+      register_method("serialize", &Wasm::serialize);
+      register_method("set_module", &Wasm::set_module);
+      register_method("get_module", &Wasm::get_module);
       register_method("instantiate", &Wasm::instantiate);
       register_method("load", &Wasm::load);
+      register_method("preinitialize", &Wasm::preinitialize);
       register_method("inspect", &Wasm::inspect);
       register_method("global", &Wasm::global);
+      register_method("snapshot", &Wasm::snapshot);
+      register_method("restore", &Wasm::restore);
       register_method("function", &Wasm::function);
+      register_method("get_function", &Wasm::get_function);
+      register_method("function_batch", &Wasm::function_batch);
+      register_method("function_resumable", &Wasm::function_resumable);
+      register_method("is_calling", &Wasm::is_calling);
+      register_method("get_last_error", &Wasm::get_last_error);
       register_property<Wasm, Ref<WasmMemory>>("memory", &Wasm::memory, NULL);
       register_property<Wasm, PackedStringArray>("extensions", &Wasm::extensions, PackedStringArray());
+      register_property<Wasm, int64_t>("execution_budget", &Wasm::set_execution_budget, &Wasm::get_execution_budget, 0);
+      register_property<Wasm, bool>("print_output", &Wasm::set_print_output, &Wasm::get_print_output, true);
     #else
       ClassDB::bind_method(D_METHOD("compile", "bytecode"), &Wasm::compile);
+      ClassDB::bind_method(D_METHOD("compile_serialized", "bytes"), &Wasm::compile_serialized);
+      ClassDB::bind_method(D_METHOD("compile_async", "bytecode"), &Wasm::compile_async);
+      ClassDB::bind_method(D_METHOD("is_compiling"), &Wasm::is_compiling);
+      ClassDB::bind_method(D_METHOD("serialize"), &Wasm::serialize);
+      ClassDB::bind_method(D_METHOD("set_module", "module"), &Wasm::set_module);
+      ClassDB::bind_method(D_METHOD("get_module"), &Wasm::get_module);
       ClassDB::bind_method(D_METHOD("instantiate", "import_map"), &Wasm::instantiate);
       ClassDB::bind_method(D_METHOD("load", "bytecode", "import_map"), &Wasm::load);
+      ClassDB::bind_method(D_METHOD("preinitialize", "bytecode", "import_map"), &Wasm::preinitialize);
       ClassDB::bind_method(D_METHOD("inspect"), &Wasm::inspect);
       ClassDB::bind_method(D_METHOD("global", "name"), &Wasm::global);
+      ClassDB::bind_method(D_METHOD("snapshot"), &Wasm::snapshot);
+      ClassDB::bind_method(D_METHOD("restore", "snapshot"), &Wasm::restore);
       ClassDB::bind_method(D_METHOD("function", "name", "args"), &Wasm::function, DEFVAL(Array()));
+      ClassDB::bind_method(D_METHOD("get_function", "name"), &Wasm::get_function);
+      ClassDB::bind_method(D_METHOD("function_batch", "name", "args", "stride"), &Wasm::function_batch);
+      ClassDB::bind_method(D_METHOD("function_resumable", "name", "args"), &Wasm::function_resumable, DEFVAL(Array()));
+      ClassDB::bind_method(D_METHOD("is_calling"), &Wasm::is_calling);
+      ClassDB::bind_method(D_METHOD("get_last_error"), &Wasm::get_last_error);
       ClassDB::bind_method(D_METHOD("set_extensions"), &Wasm::set_extensions);
       ClassDB::bind_method(D_METHOD("get_extensions"), &Wasm::get_extensions);
       ClassDB::bind_method(D_METHOD("get_memory"), &Wasm::get_memory);
+      ClassDB::bind_method(D_METHOD("set_execution_budget", "budget"), &Wasm::set_execution_budget);
+      ClassDB::bind_method(D_METHOD("get_execution_budget"), &Wasm::get_execution_budget);
+      ClassDB::bind_method(D_METHOD("set_print_output", "print"), &Wasm::set_print_output);
+      ClassDB::bind_method(D_METHOD("get_print_output"), &Wasm::get_print_output);
       ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "extensions"), "set_extensions", "get_extensions");
       ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "memory"), "", "get_memory");
+      ADD_PROPERTY(PropertyInfo(Variant::INT, "execution_budget"), "set_execution_budget", "get_execution_budget");
+      ADD_PROPERTY(PropertyInfo(Variant::BOOL, "print_output"), "set_print_output", "get_print_output");
+      ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "module"), "set_module", "get_module");
+      ADD_SIGNAL(MethodInfo("compiled", PropertyInfo(Variant::INT, "error")));
+      ADD_SIGNAL(MethodInfo("output", PropertyInfo(Variant::INT, "fd"), PropertyInfo(Variant::STRING, "text")));
     #endif
   }
 
   Wasm::Wasm() {
-    module = NULL;
     instance = NULL;
+    generation = 0;
+    compile_task = -1;
+    execution_budget = 0;
+    last_error = OK;
+    exiting = false;
+    exit_code = 0;
+    flush_pending = false;
+    worker = godot_wasm::create_worker();
+    print_output = true;
+    wasm_extern_vec_new_empty(&exports);
     memory_context = NULL;
     reset_instance(); // Set initial state
     extensions.append("wasi_preview1"); // Default enabled extensions
@@ -248,30 +477,195 @@ namespace godot {
 
   Wasm::~Wasm() {
     reset_instance();
-    unset(module, wasm_module_delete);
+    reset_names();
   }
 
   void Wasm::_init() {}
 
-  void Wasm::exit(int32_t code) {
+  wasm_trap_t* Wasm::exit(int32_t code) {
+    // Guest call unwinds via trap; instance is reset once the call has returned to its caller
+    exiting = true;
+    exit_code = code;
+    wasm_message_t message;
+    DEFER(wasm_byte_vec_delete(&message));
+    wasm_name_new_from_string_nt(&message, "Module exited");
+    return wasm_trap_new(store.get(), &message);
+  }
+
+  void Wasm::finish_exit() const {
+    if (exiting) const_cast<Wasm*>(this)->exit_instance();
+  }
+
+  void Wasm::exit_instance() {
+    const int32_t code = exit_code;
+    exiting = false;
+    flush_output();
     reset_instance(); // Reset instance state
     code ? PRINT_ERROR("Module exited with error " + String::num_int64(code)) : PRINT("Module exited successfully");
     // TODO: Emit signal
   }
 
   void Wasm::reset_instance() {
+    wasm_extern_vec_delete(&exports);
+    wasm_extern_vec_new_empty(&exports);
     unset(instance, wasm_instance_delete);
-    unset(memory_context);
+    store.reset(); // Memory may outlive instance and retains store
+    generation++; // Invalidate function handles
     memory = Ref<WasmMemory>(NULL);
+    wasi_files.reset();
+    for (auto &it: export_funcs) it.second.func = NULL;
+    for (auto &it: export_globals) it.second.global = NULL;
+  }
+
+  void Wasm::reset_names() {
+    // Module metadata outlives instances as exported function scratch space may be in use by an exiting guest
+    memory_context = NULL;
     import_funcs.clear();
     export_globals.clear();
     export_funcs.clear();
   }
 
+  Dictionary Wasm::snapshot() const {
+    FAIL_IF(instance == NULL, "Not instantiated", Dictionary());
+    FAIL_IF(is_busy(), "Call in progress", Dictionary());
+
+    // Capture mutable numeric exported globals; unexported globals are inaccessible via the Wasm C API
+    Dictionary globals;
+    for (const auto &it: export_globals) {
+      if (it.second.global == NULL) continue;
+      bool variable;
+      const wasm_valkind_t kind = get_global_kind(it.second.global, &variable);
+      if (!variable || kind == WASM_EXTERNREF || kind == WASM_FUNCREF) continue;
+      wasm_val_t value;
+      wasm_global_get(it.second.global, &value);
+      globals[it.first] = decode_variant(value);
+    }
+
+    Dictionary dict;
+    dict["globals"] = globals;
+    // Imported memory is shared with other instances so is left to its owner
+    if (memory.is_valid() && memory_context && !memory_context->import) {
+      dict["memory"] = memory->read_bytes(0, wasm_memory_data_size(memory->get_memory()));
+    }
+    return dict;
+  }
+
+  godot_error Wasm::restore(const Dictionary snapshot) {
+    FAIL_IF(instance == NULL, "Not instantiated", ERR_UNCONFIGURED);
+    FAIL_IF(is_busy(), "Call in progress", ERR_BUSY);
+
+    // Validate entire snapshot before mutating any state so a failed restore leaves the instance unchanged
+    const bool has_memory = snapshot.has("memory");
+    if (has_memory) {
+      FAIL_IF(memory.is_null() || memory_context == NULL || memory_context->import, "Invalid snapshot memory", ERR_INVALID_DATA);
+      FAIL_IF(snapshot["memory"].get_type() != Variant::PACKED_BYTE_ARRAY, "Invalid snapshot memory", ERR_INVALID_DATA);
+      FAIL_IF((size_t)((PackedByteArray)snapshot["memory"]).size() > wasm_memory_data_size(memory->get_memory()), "Snapshot larger than memory", ERR_PARAMETER_RANGE_ERROR);
+    }
+
+    const Dictionary globals = dict_safe_get(snapshot, "globals", Dictionary());
+    const Array keys = globals.keys();
+    std::vector<std::pair<wasm_global_t*, wasm_val_t>> values;
+    for (int64_t i = 0; i < keys.size(); i++) {
+      const auto it = export_globals.find(keys[i]);
+      FAIL_IF(it == export_globals.end() || it->second.global == NULL, "Unknown global name " + String(keys[i]), ERR_INVALID_DATA);
+      bool variable;
+      const wasm_valkind_t kind = get_global_kind(it->second.global, &variable);
+      FAIL_IF(!variable || wasm_valkind_is_ref(kind), "Invalid snapshot global " + String(keys[i]), ERR_INVALID_DATA);
+      const wasm_val_t value = encode_variant(globals[keys[i]], kind);
+      FAIL_IF(value.kind == WASM_EXTERNREF, "Invalid snapshot global " + String(keys[i]), ERR_INVALID_DATA);
+      values.push_back({ (wasm_global_t*)it->second.global, value });
+    }
+
+    if (has_memory) {
+      const godot_error err = memory->restore(snapshot["memory"]);
+      if (err != OK) return err;
+    }
+    for (const auto &it: values) wasm_global_set(it.first, &it.second);
+    return OK;
+  }
+
   Ref<WasmMemory> Wasm::get_memory() const {
     return memory;
   };
 
+  godot_wasm::WasiFiles& Wasm::get_wasi_files() {
+    return wasi_files;
+  }
+
+  void Wasm::write_output(int32_t fd, const char* data, size_t length) {
+    // Coalesce guest writes such that each line is output once regardless of fragmentation
+    bool full;
+    {
+      std::lock_guard<std::mutex> lock(output_mutex);
+      std::string& buffer = output_buffers[fd == 1 ? 0 : 1];
+      buffer.append(data, length);
+      full = buffer.size() >= OUTPUT_BUFFER_MAX;
+    }
+    // Resumable calls run on a worker thread so defer output until completion on main thread
+    if (is_calling()) return;
+    if (full || memchr(data, '\n', length)) emit_output(fd, full);
+    defer_flush(); // Incomplete lines are kept across calls and flushed at most once per frame
+  }
+
+  void Wasm::flush_output() const {
+    emit_output(1, true);
+    emit_output(2, true);
+  }
+
+  void Wasm::release_output() const {
+    emit_output(1, false);
+    emit_output(2, false);
+    defer_flush();
+  }
+
+  void Wasm::defer_flush() const {
+    {
+      std::lock_guard<std::mutex> lock(output_mutex);
+      if (output_buffers[0].empty() && output_buffers[1].empty()) return;
+    }
+    if (flush_pending.exchange(true)) return;
+    callable_mp(const_cast<Wasm*>(this), &Wasm::flush_deferred).call_deferred();
+  }
+
+  void Wasm::flush_deferred() {
+    flush_pending = false;
+    if (is_calling()) return; // Released once resumable call completes
+    flush_output();
+  }
+
+  void Wasm::emit_output(int32_t fd, bool partial) const {
+    // Emit complete lines and, if partial, any trailing incomplete line
+    // Lines are taken under lock and emitted after as pool instances write output on worker threads
+    std::vector<String> lines;
+    {
+      std::lock_guard<std::mutex> lock(output_mutex);
+      std::string& buffer = output_buffers[fd == 1 ? 0 : 1];
+      size_t begin = 0;
+      while (begin < buffer.size()) {
+        size_t end = buffer.find('\n', begin);
+        if (end == std::string::npos) {
+          if (!partial) break;
+          end = buffer.size();
+        }
+        lines.push_back(String::utf8(buffer.data() + begin, end - begin));
+        begin = end + 1;
+      }
+      buffer.erase(0, begin);
+    }
+    for (const String& line: lines) {
+      if (print_output) fd == 1 ? PRINT(line) : PRINT_ERROR(line);
+      EMIT_SIGNAL_MAIN_THREAD(const_cast<Wasm*>(this), "output", fd, line);
+    }
+  }
+
+  void Wasm::set_print_output(bool print) {
+    print_output = print;
+  }
+
+  bool Wasm::get_print_output() const {
+    return print_output;
+  }
+
   void Wasm::set_extensions(const PackedStringArray &extension_names) {
     extensions = extension_names;
   }
@@ -281,69 +675,136 @@ namespace godot {
   }
 
   godot_error Wasm::compile(PackedByteArray bytecode) {
-    reset_instance(); // Reset instance
-    unset(module, wasm_module_delete); // Reset module
+    FAIL_IF(is_compiling(), "Compilation in progress", ERR_BUSY);
+    FAIL_IF(is_calling(), "Call in progress", ERR_BUSY);
+    Ref<WasmModule> compiled;
+    INSTANTIATE_REF(compiled);
+    godot_error err = compiled->compile(bytecode);
+    set_module(err == OK ? compiled : Ref<WasmModule>());
+    return err;
+  }
 
-    // Load binary
-    wasm_byte_vec_t wasm_bytes;
-    DEFER(wasm_byte_vec_delete(&wasm_bytes));
-    wasm_byte_vec_new(&wasm_bytes, bytecode.size(), (const wasm_byte_t*)BYTE_ARRAY_POINTER(bytecode));
+  godot_error Wasm::compile_serialized(PackedByteArray bytes) {
+    FAIL_IF(is_compiling(), "Compilation in progress", ERR_BUSY);
+    FAIL_IF(is_calling(), "Call in progress", ERR_BUSY);
+    Ref<WasmModule> compiled;
+    INSTANTIATE_REF(compiled);
+    godot_error err = compiled->compile_serialized(bytes);
+    set_module(err == OK ? compiled : Ref<WasmModule>());
+    return err;
+  }
 
-    // Validate binary
-    FAIL_IF(!wasm_module_validate(STORE, &wasm_bytes), "Invalid binary", ERR_INVALID_DATA);
+  godot_error Wasm::compile_async(PackedByteArray bytecode) {
+    FAIL_IF(is_compiling(), "Compilation in progress", ERR_BUSY);
+    FAIL_IF(is_calling(), "Call in progress", ERR_BUSY);
+    set_module(Ref<WasmModule>()); // Discard module and instance until compilation completes
+    godot_wasm::Store::instance(); // Ensure engine is configured on the calling thread
+    Ref<WasmModule> compiled;
+    INSTANTIATE_REF(compiled);
+    // Callables hold references so the instance outlives compilation
+    const Callable task = callable_mp_static(&Wasm::compile_worker).bind(Ref<Wasm>(this), compiled, bytecode);
+    compile_task = WorkerThreadPool::get_singleton()->add_task(task, false, "Compile Wasm module");
+    return OK;
+  }
 
-    // Compile
-    module = wasm_module_new(STORE, &wasm_bytes);
-    FAIL_IF(module == NULL, "Compilation failed", ERR_COMPILATION_FAILED);
+  void Wasm::compile_worker(Ref<Wasm> wasm, Ref<WasmModule> compiled, PackedByteArray bytecode) {
+    const godot_error err = compiled->compile(bytecode);
+    callable_mp_static(&Wasm::compile_finish).call_deferred(wasm, compiled, (int64_t)err);
+  }
 
-    // Map names to export indices
-    FAIL_IF(map_names(), "Failed to parse module imports or exports", ERR_COMPILATION_FAILED);
+  void Wasm::compile_finish(Ref<Wasm> wasm, Ref<WasmModule> compiled, int64_t error) {
+    // Called on main thread once worker has completed
+    WorkerThreadPool::get_singleton()->wait_for_task_completion(wasm->compile_task);
+    wasm->compile_task = -1;
+    wasm->set_module(error == OK ? compiled : Ref<WasmModule>());
+    wasm->emit_signal("compiled", error);
+  }
 
-    return OK;
+  bool Wasm::is_compiling() const {
+    return compile_task >= 0;
+  }
+
+  PackedByteArray Wasm::serialize() const {
+    FAIL_IF(module.is_null(), "Serialization failed", PackedByteArray());
+    return module->serialize();
+  }
+
+  void Wasm::set_module(const Ref<WasmModule> &module_new) {
+    if (is_compiling() || is_calling()) {
+      PRINT_ERROR(is_compiling() ? "Compilation in progress" : "Call in progress");
+      return;
+    }
+    flush_output(); // Output of replaced instance
+    reset_instance(); // Reset instance
+    reset_names(); // Reset module imports and exports
+    module = module_new;
+    if (module.is_null()) return;
+
+    // Copy module metadata; handles and call state are per instance
+    memory_context = module->memory_context;
+    import_funcs = module->import_funcs;
+    export_globals = module->export_globals;
+    export_funcs = module->export_funcs;
+  }
+
+  Ref<WasmModule> Wasm::get_module() const {
+    return module;
   }
 
   godot_error Wasm::instantiate(const Dictionary import_map) {
+    FAIL_IF(is_compiling(), "Compilation in progress", ERR_BUSY);
+    FAIL_IF(is_calling(), "Call in progress", ERR_BUSY);
+    FAIL_IF(module.is_null(), "Not compiled", ERR_UNCONFIGURED);
+
     // Prepare module externs
     std::map<uint16_t, wasm_extern_t*> extern_map;
 
+    // Configure import memory
+    WasmMemory* import_memory = NULL;
+    if (memory_context && memory_context->import) {
+      import_memory = dict_safe_get<WasmMemory>(import_map, "memory");
+      FAIL_IF(import_memory == NULL, "Missing import memory", ERR_CANT_CREATE);
+      FAIL_IF(import_memory->get_memory() == NULL, "Invalid import memory", ERR_CANT_CREATE);
+      // Validate limits per import matching rules; memory may be exported by another instance
+      const wasm_limits_t& expected = memory_context->limits;
+      const wasm_limits_t provided = import_memory->get_limits();
+      FAIL_IF(wasm_memory_size(import_memory->get_memory()) < expected.min, "Import memory smaller than module minimum", ERR_CANT_CREATE);
+      FAIL_IF(expected.max != wasm_limits_max_default && provided.max > expected.max, "Import memory maximum exceeds module maximum", ERR_CANT_CREATE);
+      extern_map[memory_context->index] = wasm_extern_copy(wasm_memory_as_extern(import_memory->get_memory()));
+    }
+
+    // Externs cannot cross stores; adopt that of imported memory
+    const godot_wasm::store_ptr instance_store = import_memory ? import_memory->get_store() : godot_wasm::Store::create();
+
     // Construct import functions
     const Dictionary& functions = dict_safe_get(import_map, "functions", Dictionary());
 
-    // Instantiate enabled extensions to provide default/fallback imports
-    std::vector<godot_wasm::Extension*> enabled_extensions;
-    if (PACKED_ARRAY_HAS(extensions, "wasi_preview1")) enabled_extensions.push_back(new godot_wasm::WasiPreview1Extension(this));
+    // Enabled extensions provide default/fallback imports; resolved per import on compilation
+    const uint32_t enabled_extensions = godot_wasm::extension_mask(extensions);
 
     for (const auto &it: import_funcs) {
-      if (!functions.keys().has(it.first)) {
-        // Import not explicitly provided; query extensions for import
-        wasm_func_t* callback = NULL;
-        for (auto &extension: enabled_extensions) {
-          callback = extension->get_callback(it.first);
-          if (callback) break;
-        }
-        FAIL_IF(callback == NULL, "Missing import function " + it.first, ERR_CANT_CREATE);
-        extern_map[it.second.index] = wasm_func_as_extern(callback);
+      if (!functions.has(it.first)) {
+        // Import not explicitly provided; fall back to extension
+        const godot_wasm::ExtensionFunction* extension = it.second.extension;
+        FAIL_IF(extension == NULL || !(extension->extension & enabled_extensions), "Missing import function " + it.first, ERR_CANT_CREATE);
+        extern_map[it.second.index] = wasm_func_as_extern(godot_wasm::extension_callback(extension, this, instance_store.get(), it.second.func_type));
         continue;
       }
-      const Array& import = dict_safe_get(functions, it.first, Array());
-      FAIL_IF(import.size() != 2, "Invalid import function " + it.first, ERR_CANT_CREATE);
-      FAIL_IF(import[0].get_type() != Variant::OBJECT, "Invalid import target " + it.first, ERR_CANT_CREATE);
-      FAIL_IF(!INSTANCE_VALIDATE(import[0]), "Invalid import target " + it.first, ERR_CANT_CREATE);
-      FAIL_IF(import[1].get_type() != Variant::STRING, "Invalid import method " + it.first, ERR_CANT_CREATE);
       godot_wasm::ContextFuncImport* context = (godot_wasm::ContextFuncImport*)&it.second;
-      context->target = import[0].operator Object*()->get_instance_id();
-      context->method = import[1];
-      extern_map[it.second.index] = wasm_func_as_extern(create_callback(context));
-    }
-
-    // Configure import memory
-    WasmMemory* import_memory = NULL;
-    if (memory_context && memory_context->import) {
-      import_memory = dict_safe_get<WasmMemory>(import_map, "memory");
-      FAIL_IF(import_memory == NULL, "Missing import memory", ERR_CANT_CREATE);
-      FAIL_IF(import_memory->get_memory() == NULL, "Invalid import memory", ERR_CANT_CREATE);
-      // TODO: Validate memory limits
-      extern_map[memory_context->index] = wasm_extern_copy(wasm_memory_as_extern(import_memory->get_memory()));
+      if (functions[it.first].get_type() == Variant::CALLABLE) { // Callable e.g. method, lambda, bound method
+        const Callable callable = functions[it.first];
+        FAIL_IF(callable.is_null(), "Invalid import function " + it.first, ERR_CANT_CREATE);
+        FAIL_IF(!target_valid(callable), "Invalid import target " + it.first, ERR_CANT_CREATE);
+        resolve_target(context, callable);
+      } else { // Array of object and method name
+        const Array& import = dict_safe_get(functions, it.first, Array());
+        FAIL_IF(import.size() != 2, "Invalid import function " + it.first, ERR_CANT_CREATE);
+        FAIL_IF(import[0].get_type() != Variant::OBJECT, "Invalid import target " + it.first, ERR_CANT_CREATE);
+        FAIL_IF(!INSTANCE_VALIDATE(import[0]), "Invalid import target " + it.first, ERR_CANT_CREATE);
+        FAIL_IF(import[1].get_type() != Variant::STRING, "Invalid import method " + it.first, ERR_CANT_CREATE);
+        resolve_target(context, Callable(import[0].operator Object*(), StringName(import[1].operator String())));
+      }
+      extern_map[it.second.index] = wasm_func_as_extern(create_callback(context, instance_store.get()));
     }
 
     // Sort imports by index
@@ -354,28 +815,37 @@ namespace godot {
     DEFER(wasm_extern_vec_delete(&imports));
     wasm_extern_vec_new(&imports, extern_list.size(), extern_list.data());
 
+    // Flush output of previous instance then discard it and its exports
+    flush_output();
+    wasm_extern_vec_delete(&exports);
+    wasm_extern_vec_new_empty(&exports);
+    unset(instance, wasm_instance_delete);
+    wasi_files.reset();
+    store = instance_store;
+    worker = import_memory && import_memory->get_worker() ? import_memory->get_worker() : godot_wasm::create_worker();
+
     // Instantiate with imports
-    instance = wasm_instance_new(STORE, module, &imports, NULL);
+    instance = wasm_instance_new(store.get(), module->module, &imports, NULL);
+    generation++; // Invalidate function handles
     FAIL_IF(instance == NULL, "Instantiation failed", ERR_CANT_CREATE);
 
+    // Resolve export handles once rather than per call
+    wasm_instance_exports(instance, &exports);
+    for (auto &it: export_funcs) it.second.func = wasm_extern_as_func(exports.data[it.second.index]);
+    for (auto &it: export_globals) it.second.global = wasm_extern_as_global(exports.data[it.second.index]);
+
     // Set memory reference
     if (import_memory) {
       memory = Ref<WasmMemory>(import_memory);
     } else if (memory_context && !memory_context->import) {
-      wasm_extern_vec_t exports;
-      DEFER(wasm_extern_vec_delete(&exports));
-      wasm_instance_exports(instance, &exports);
       wasm_extern_t* data = exports.data[memory_context->index];
       INSTANTIATE_REF(memory);
-      memory->set_memory(wasm_extern_as_memory(wasm_extern_copy(data)));
+      memory->set_memory(wasm_extern_as_memory(wasm_extern_copy(data)), store, worker);
     }
 
     // Call exported WASI initialize function
     if (export_funcs.count("_initialize")) function("_initialize", Array());
 
-    // Clean up allocated extensions
-    for (auto* extension: enabled_extensions) delete extension;
-
     return OK;
   }
 
@@ -386,38 +856,58 @@ namespace godot {
     return instantiate(import_map);
   }
 
+  PackedByteArray Wasm::preinitialize(PackedByteArray bytecode, const Dictionary import_map) {
+    // Locate internal state and instantiate module instrumented to export it
+    godot_wasm::Preinitializer preinitializer;
+    if (preinitializer.parse(bytecode) != OK) return PackedByteArray();
+
+    // Instrumented module runs in a separate instance so this instance is left untouched
+    Ref<Wasm> scratch;
+    INSTANTIATE_REF(scratch);
+    scratch->extensions = extensions;
+    scratch->print_output = print_output;
+    const godot_error err = scratch->load(preinitializer.instrument(), import_map);
+    FAIL_IF(err != OK, "Failed to instantiate module for pre-initialization", PackedByteArray());
+    FAIL_IF(scratch->instance == NULL, "Module exited during initialization", PackedByteArray());
+
+    // Capture initialized state
+    std::vector<wasm_val_t> values;
+    for (const auto &global: preinitializer.globals) {
+      const auto it = scratch->export_globals.find(godot_wasm::Preinitializer::global_name(global.index));
+      FAIL_IF(it == scratch->export_globals.end() || it->second.global == NULL, "Failed to retrieve initialized global", PackedByteArray());
+      wasm_val_t value;
+      wasm_global_get(it->second.global, &value);
+      values.push_back(value);
+    }
+    const Ref<WasmMemory> scratch_memory = scratch->memory;
+    const PackedByteArray data = scratch_memory.is_valid() ? scratch_memory->read_bytes(0, wasm_memory_data_size(scratch_memory->get_memory())) : PackedByteArray();
+    return preinitializer.bake(values, data);
+  }
+
   Dictionary Wasm::inspect() const {
     // Validate module
-    FAIL_IF(module == NULL, "Inspection failed", Dictionary());
-
-    // Module extern names and signatures
-    Dictionary import_func_sigs, export_global_sigs, export_func_sigs;
-    for (const auto &tuple: import_funcs) import_func_sigs[tuple.first] = get_extern_signature(module, tuple.second.index, true);
-    for (const auto &tuple: export_globals) export_global_sigs[tuple.first] = get_extern_signature(module, tuple.second.index, false);
-    for (const auto &tuple: export_funcs) export_func_sigs[tuple.first] = get_extern_signature(module, tuple.second.index, false);
-
-    // Module info dictionary
-    Dictionary dict;
-    dict["import_functions"] = import_func_sigs;
-    dict["export_globals"] = export_global_sigs;
-    dict["export_functions"] = export_func_sigs;
-    Dictionary dict_memory = memory != NULL && memory->get_memory() ? memory->inspect() : get_memory_limits(module, memory_context);
-    if (memory_context != NULL) dict_memory["import"] = memory_context->import;
-    dict["memory"] = dict_memory;
+    FAIL_IF(module.is_null(), "Inspection failed", Dictionary());
+    FAIL_IF(is_busy(), "Call in progress", Dictionary());
+
+    // Module info with live memory limits if instantiated
+    Dictionary dict = module->inspect();
+    if (memory_context != NULL && memory.is_valid() && memory->get_memory()) {
+      Dictionary dict_memory = memory->inspect();
+      dict_memory["import"] = memory_context->import;
+      dict["memory"] = dict_memory;
+    }
     return dict;
   }
 
   Variant Wasm::global(String name) const {
     // Validate instance and global name
     FAIL_IF(instance == NULL, "Not instantiated", NULL_VARIANT);
-    FAIL_IF(!export_globals.count(name), "Unknown global name " + name, NULL_VARIANT);
+    FAIL_IF(is_busy(), "Call in progress", NULL_VARIANT);
+    const auto it = export_globals.find(name);
+    FAIL_IF(it == export_globals.end(), "Unknown global name " + name, NULL_VARIANT);
 
     // Retrieve exported global
-    wasm_extern_vec_t exports;
-    DEFER(wasm_extern_vec_delete(&exports));
-    wasm_instance_exports(instance, &exports);
-    wasm_extern_t* data = exports.data[export_globals.at(name).index];
-    const wasm_global_t* global = wasm_extern_as_global(data);
+    const wasm_global_t* global = it->second.global;
     FAIL_IF(global == NULL, "Failed to retrieve global export " + name, NULL_VARIANT);
 
     // Extract result
@@ -427,109 +917,155 @@ namespace godot {
   }
 
   Variant Wasm::function(String name, Array args) const {
+    FAIL_IF(is_busy(), "Call in progress", NULL_VARIANT); // Error of call in progress is left untouched
+    last_error = FAILED;
     // Validate instance and function name
     FAIL_IF(instance == NULL, "Not instantiated", NULL_VARIANT);
-    FAIL_IF(!export_funcs.count(name), "Unknown function name " + name, NULL_VARIANT);
+    const auto it = export_funcs.find(name);
+    FAIL_IF(it == export_funcs.end(), "Unknown function name " + name, NULL_VARIANT);
+    return invoke(it->second, name, args);
+  }
 
-    // Retrieve exported function
-    wasm_extern_vec_t exports;
-    DEFER(wasm_extern_vec_delete(&exports));
-    wasm_instance_exports(instance, &exports);
-    godot_wasm::ContextFuncExport context = export_funcs.at(name);
-    wasm_extern_t* data = exports.data[context.index];
-    const wasm_func_t* func = wasm_extern_as_func(data);
-    FAIL_IF(func == NULL, "Failed to retrieve function export " + name, NULL_VARIANT);
-
-    // Validate argument count
-    FAIL_IF(context.params.size() != args.size(), "Incorrect number of arguments supplied", NULL_VARIANT);
-
-    // Construct args
-    std::vector<wasm_val_t> args_vec;
-    for (uint16_t i = 0; i < args.size(); i++) {
-      Variant variant = args[i];
-      wasm_val_t value = encode_variant(variant, context.params[i]);
-      FAIL_IF(value.kind == WASM_EXTERNREF, "Invalid argument type", NULL_VARIANT);
-      args_vec.push_back(value);
-    }
-    wasm_val_vec_t f_args;
-    DEFER(wasm_val_vec_delete(&f_args));
-    wasm_val_vec_new(&f_args,  args_vec.size(), args_vec.data());
-
-    // Construct return values
-    wasm_val_vec_t f_results;
-    DEFER(wasm_val_vec_delete(&f_results));
-    wasm_val_vec_new_uninitialized(&f_results,  context.return_count);
-
-    // Call function
-    FAIL_IF(wasm_func_call(func, &f_args, &f_results), "Failed calling function " + name, NULL_VARIANT);
-
-    // Extract result(s)
-    if (context.return_count == 0) return NULL_VARIANT;
-    if (context.return_count == 1) return decode_variant(f_results.data[0]);
-    Array results = Array();
-    for (uint16_t i = 0; i < context.return_count; i++) results.append(decode_variant(f_results.data[i]));
-    return results;
+  Ref<WasmFunction> Wasm::get_function(String name) {
+    // Validate instance and function name
+    FAIL_IF(instance == NULL, "Not instantiated", Ref<WasmFunction>());
+    const auto it = export_funcs.find(name);
+    FAIL_IF(it == export_funcs.end(), "Unknown function name " + name, Ref<WasmFunction>());
+
+    // Handle holds resolved context; invalidated when instance changes
+    Ref<WasmFunction> ref;
+    INSTANTIATE_REF(ref);
+    ref->bind(this, name, &it->second, generation);
+    return ref;
   }
 
-  godot_error Wasm::map_names() {
-    // Module imports
-    wasm_importtype_vec_t imports;
-    DEFER(wasm_importtype_vec_delete(&imports));
-    wasm_module_imports(module, &imports);
-    for (uint16_t i = 0; i < imports.size; i++) {
-      const wasm_externtype_t* type = wasm_importtype_type(imports.data[i]);
-      const wasm_externkind_t kind = wasm_externtype_kind(type);
-      const String key = decode_name(wasm_importtype_module(imports.data[i])) + "." + decode_name(wasm_importtype_name(imports.data[i]));
-      switch (kind) {
-        case WASM_EXTERN_FUNC: {
-          const wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
-          import_funcs.emplace(key, godot_wasm::ContextFuncImport(i, func_type));
-          break;
-        } case WASM_EXTERN_MEMORY:
-          memory_context = new godot_wasm::ContextMemory(i, true);
-          break;
-        case WASM_EXTERN_TABLE:
-          WARN_PRINT("Tables not implemented for import " + key);
-          break;
-        default: WARN_PRINT("Type not implemented for import " + key);
-      }
-    }
+  Ref<WasmCall> Wasm::function_resumable(String name, Array args) {
+    FAIL_IF(instance == NULL, "Not instantiated", Ref<WasmCall>());
+    FAIL_IF(is_calling(), "Call in progress", Ref<WasmCall>());
+    FAIL_IF(export_funcs.count(name) == 0, "Unknown function name " + name, Ref<WasmCall>());
+
+    // Instance is reserved for the call until it completes on a worker thread
+    *worker = WORKER_PENDING;
+    Ref<WasmCall> call;
+    INSTANTIATE_REF(call);
+    call->start(this, name, args);
+    return call;
+  }
 
-    // Module exports
-    wasm_exporttype_vec_t exports;
-    DEFER(wasm_exporttype_vec_delete(&exports));
-    wasm_module_exports(module, &exports);
-    for (uint16_t i = 0; i < exports.size; i++) {
-      const wasm_externtype_t* type = wasm_exporttype_type(exports.data[i]);
-      const wasm_externkind_t kind = wasm_externtype_kind(type);
-      const String key = decode_name(wasm_exporttype_name(exports.data[i]));
-      switch (kind) {
-        case WASM_EXTERN_FUNC: {
-          const wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
-          export_funcs.emplace(key, godot_wasm::ContextFuncExport(i, func_type));
-          break;
-        } case WASM_EXTERN_GLOBAL:
-          export_globals.emplace(key, godot_wasm::ContextExtern(i));
-          break;
-        case WASM_EXTERN_MEMORY:
-          if (memory_context == NULL) memory_context = new godot_wasm::ContextMemory(i, false); // Favour import memory
-          break;
-        case WASM_EXTERN_TABLE:
-          WARN_PRINT("Tables not implemented for export " + key);
-          break;
-        default: WARN_PRINT("Type not implemented for export " + key);
-      }
-    }
+  Variant Wasm::call_resumable(const String& name, const Array& args) {
+    // Runs to completion on a worker thread; store is reserved so only host functions called by the guest may use it
+    *worker = THREAD_ID;
+    const godot_wasm::store_ptr guard = store;
+    last_error = FAILED;
+    const auto it = export_funcs.find(name);
+    refuel();
+    const Variant result = call_export(instance, it->second, name, args, args.size(), exiting, last_error);
+    *worker = WORKER_PENDING; // Reserved until released on main thread by WasmCall
+    return result;
+  }
+
+  bool Wasm::is_calling() const {
+    return *worker != WORKER_NONE;
+  }
+
+  bool Wasm::is_busy() const {
+    return godot_wasm::worker_busy(worker);
+  }
+
+  uint64_t Wasm::get_generation() const {
+    return generation;
+  }
 
+  godot_error Wasm::get_last_error() const {
+    if (is_calling()) return ERR_BUSY; // Written by resumable call's worker thread until released
+    return last_error;
+  }
+
+  godot_error Wasm::set_execution_budget(int64_t budget) {
+    FAIL_IF(budget < 0, "Invalid execution budget", ERR_INVALID_PARAMETER);
+    // Budgets would otherwise be silently unbounded e.g. with Wasmtime, where budgets are out of scope, or metering disabled
+    FAIL_IF(budget && !godot_wasm::Store::instance().metered, "Execution budget unavailable without metering", ERR_UNAVAILABLE);
+    execution_budget = budget;
     return OK;
   }
 
-  wasm_func_t* Wasm::create_callback(godot_wasm::ContextFuncImport* context) {
-    wasm_importtype_vec_t imports;
-    DEFER(wasm_importtype_vec_delete(&imports));
-    wasm_module_imports(module, &imports);
-    const wasm_externtype_t* type = wasm_importtype_type(imports.data[context->index]);
-    const wasm_functype_t* func_type = wasm_externtype_as_functype((wasm_externtype_t*)type);
-    return wasm_func_new_with_env(STORE, func_type, callback_wrapper, context, NULL);
+  int64_t Wasm::get_execution_budget() const {
+    return execution_budget;
+  }
+
+  void Wasm::refuel() const {
+    if (instance != NULL && godot_wasm::Store::instance().metered) godot_wasm::set_budget(instance, execution_budget);
+  }
+
+  Variant Wasm::invoke(const godot_wasm::ContextFuncExport& context, const String& name, const Array& args) const {
+    FAIL_IF(is_busy(), "Call in progress", NULL_VARIANT);
+    last_error = FAILED;
+    const godot_wasm::store_ptr guard = store; // Guest exiting resets instance once call returns
+    refuel();
+    const Variant result = call_export(instance, context, name, args, args.size(), exiting, last_error);
+    if (memory.is_valid()) memory->poll_growth(); // Notify of growth by guest
+    finish_exit();
+    return result;
+  }
+
+  Variant Wasm::invoke(const godot_wasm::ContextFuncExport& context, const String& name, const Variant** args, int32_t count) const {
+    FAIL_IF(is_busy(), "Call in progress", NULL_VARIANT);
+    last_error = FAILED;
+    const godot_wasm::store_ptr guard = store; // Guest exiting resets instance once call returns
+    refuel();
+    const Variant result = call_export(instance, context, name, args, count, exiting, last_error);
+    if (memory.is_valid()) memory->poll_growth(); // Notify of growth by guest
+    finish_exit();
+    return result;
+  }
+
+  Variant Wasm::function_batch(String name, Variant args, int64_t stride) const {
+    return function_batch_range(name, args, stride, 0, -1);
+  }
+
+  Variant Wasm::function_batch_range(const String& name, const Variant& args, int64_t stride, int64_t begin, int64_t end) const {
+    FAIL_IF(is_busy(), "Call in progress", NULL_VARIANT);
+    last_error = FAILED;
+    // Validate instance and function name
+    FAIL_IF(instance == NULL, "Not instantiated", NULL_VARIANT);
+    const auto it = export_funcs.find(name);
+    FAIL_IF(it == export_funcs.end(), "Unknown function name " + name, NULL_VARIANT);
+    const godot_wasm::ContextFuncExport& context = it->second;
+    FAIL_IF(context.func == NULL, "Failed to retrieve function export " + name, NULL_VARIANT);
+
+    // Validate row layout
+    FAIL_IF(stride <= 0 || (size_t)stride < context.params.size(), "Invalid stride", NULL_VARIANT);
+
+    // Guest exiting resets instance once call returns
+    const godot_wasm::store_ptr guard = store;
+    refuel(); // Budget applies to batch as a whole
+
+    // Results are packed as integers only if every return type is an integer
+    bool integer = true;
+    for (const auto &kind: context.returns) integer &= kind == WASM_I32 || kind == WASM_I64;
+
+    Variant results;
+    switch (args.get_type()) {
+      case Variant::PACKED_INT64_ARRAY:
+        results = integer
+          ? call_batch<PackedInt64Array, PackedInt64Array>(instance, context, name, args, stride, begin, end, exiting, last_error)
+          : call_batch<PackedInt64Array, PackedFloat64Array>(instance, context, name, args, stride, begin, end, exiting, last_error);
+        break;
+      case Variant::PACKED_FLOAT64_ARRAY:
+        results = integer
+          ? call_batch<PackedFloat64Array, PackedInt64Array>(instance, context, name, args, stride, begin, end, exiting, last_error)
+          : call_batch<PackedFloat64Array, PackedFloat64Array>(instance, context, name, args, stride, begin, end, exiting, last_error);
+        break;
+      default: FAIL("Unsupported argument array type", NULL_VARIANT);
+    }
+    if (memory.is_valid()) memory->poll_growth(); // Notify of growth by guest
+    finish_exit();
+    return results;
+  }
+
+  wasm_func_t* Wasm::create_callback(godot_wasm::ContextFuncImport* context, wasm_store_t* store_instance) {
+    const wasm_functype_t* func_type = context->func_type;
+    const wasm_func_callback_with_env_t callback = get_callback_wrapper(func_type);
+    return wasm_func_new_with_env(store_instance, func_type, callback, context, NULL);
   }
 }
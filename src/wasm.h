@@ -2,49 +2,108 @@
 #define GODOT_WASM_H
 
 #include <map>
+#include <string>
+#include <mutex>
+#include <atomic>
 #include <wasm.h>
 #include "defs.h"
 #include "wasm-memory.h"
+#include "wasm-function.h"
+#include "wasm-call.h"
+#include "wasm-module.h"
+#include "extensions/wasi-files.h"
 
 namespace godot {
   namespace godot_wasm {
     struct ContextExtern;
     struct ContextFuncImport;
+    struct ContextGlobalExport;
     struct ContextFuncExport;
     struct ContextMemory;
   }
 
   class Wasm: public RefCounted {
     GDCLASS(Wasm, RefCounted);
+    friend class WasmCall; // Resumable calls run on a worker thread
 
     private:
-      wasm_module_t* module;
+      Ref<WasmModule> module;
       wasm_instance_t* instance;
-      godot_wasm::ContextMemory* memory_context;
+      godot_wasm::store_ptr store; // Store owning instance; shared with imported or exported memory
+      wasm_extern_vec_t exports;
+      uint64_t generation; // Incremented whenever instance changes
+      int64_t compile_task; // Pending asynchronous compilation; -1 if none
+      int64_t execution_budget; // Metering points per call; zero is unbounded
+      mutable godot_error last_error; // Result of most recent call; ERR_TIMEOUT if execution budget exceeded
+      bool exiting; // Guest exited during current call; instance is reset once the call returns
+      int32_t exit_code; // Exit code of exiting guest
+      godot_wasm::worker_ptr worker; // Resumable call running on a worker thread; shared with imported or exported memory
+      const godot_wasm::ContextMemory* memory_context; // Non-owning; held by module
       PackedStringArray extensions;
+      godot_wasm::WasiFiles wasi_files; // Open WASI file descriptors; reset with instance
+      bool print_output; // Print guest standard output and error in addition to emitting signal
+      mutable std::string output_buffers[2]; // Guest standard output and error pending complete lines; guarded by output mutex
+      mutable std::mutex output_mutex;
+      mutable std::atomic<bool> flush_pending; // Deferred flush of incomplete lines scheduled for this frame
       Ref<WasmMemory> memory;
       std::map<String, godot_wasm::ContextFuncImport> import_funcs;
-      std::map<String, godot_wasm::ContextExtern> export_globals;
+      std::map<String, godot_wasm::ContextGlobalExport> export_globals;
       std::map<String, godot_wasm::ContextFuncExport> export_funcs;
       void reset_instance();
-      godot_error map_names();
-      wasm_func_t* create_callback(godot_wasm::ContextFuncImport* context);
+      void exit_instance();
+      void finish_exit() const;
+      bool is_busy() const;
+      void reset_names();
+      void refuel() const;
+      Variant call_resumable(const String& name, const Array& args);
+      void emit_output(int32_t fd, bool partial) const;
+      void release_output() const;
+      void defer_flush() const;
+      void flush_deferred();
+      wasm_func_t* create_callback(godot_wasm::ContextFuncImport* context, wasm_store_t* store_instance);
+      static void compile_worker(Ref<Wasm> wasm, Ref<WasmModule> compiled, PackedByteArray bytecode);
+      static void compile_finish(Ref<Wasm> wasm, Ref<WasmModule> compiled, int64_t error);
 
     public:
       static void REGISTRATION_METHOD();
       Wasm();
       ~Wasm();
       void _init();
-      void exit(int32_t code);
+      wasm_trap_t* exit(int32_t code);
       godot_error compile(PackedByteArray bytecode);
+      godot_error compile_serialized(PackedByteArray bytes);
+      godot_error compile_async(PackedByteArray bytecode);
+      bool is_compiling() const;
+      PackedByteArray serialize() const;
+      void set_module(const Ref<WasmModule> &module_new);
+      Ref<WasmModule> get_module() const;
       godot_error instantiate(const Dictionary import_map);
       godot_error load(PackedByteArray bytecode, const Dictionary import_map);
+      PackedByteArray preinitialize(PackedByteArray bytecode, const Dictionary import_map);
       Dictionary inspect() const;
       Variant function(String name, Array args) const;
+      Variant function_batch(String name, Variant args, int64_t stride) const;
+      Variant function_batch_range(const String& name, const Variant& args, int64_t stride, int64_t begin, int64_t end) const;
+      Ref<WasmFunction> get_function(String name);
+      Ref<WasmCall> function_resumable(String name, Array args);
+      bool is_calling() const;
+      godot_error get_last_error() const;
+      uint64_t get_generation() const;
+      Variant invoke(const godot_wasm::ContextFuncExport& context, const String& name, const Array& args) const;
+      Variant invoke(const godot_wasm::ContextFuncExport& context, const String& name, const Variant** args, int32_t count) const;
       Variant global(String name) const;
+      Dictionary snapshot() const;
+      godot_error restore(const Dictionary snapshot);
       Ref<WasmMemory> get_memory() const;
+      godot_wasm::WasiFiles& get_wasi_files();
+      void write_output(int32_t fd, const char* data, size_t length);
+      void flush_output() const;
+      void set_print_output(bool print);
+      bool get_print_output() const;
       void set_extensions(const PackedStringArray &extension_names);
       PackedStringArray get_extensions() const;
+      godot_error set_execution_budget(int64_t budget);
+      int64_t get_execution_budget() const;
   };
 }
 